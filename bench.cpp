@@ -0,0 +1,410 @@
+/**
+ * @file    bench.cpp
+ * @author  Phil Lockett <phillockett65@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Measure the throughput of the UTF-8 code Implementation.
+ *
+ * Each benchmark is run over generated corpora of pure ASCII, Latin-1 heavy,
+ * CJK, emoji and random malformed text. The results are displayed and also
+ * written to timings.txt as tab separated values.
+ *
+ * Build using:
+ *    g++ -std=c++20 -O2 -pthread -c -o bench.o bench.cpp
+ *    g++ -std=c++20 -O2 -pthread -c -o utf_8.o utf_8.cpp
+ *    g++ -std=c++20 -O2 -c -o kernels.o kernels.cpp
+ *    g++ -std=c++20 -O2 -pthread -o bench bench.o utf_8.o kernels.o
+ *
+ * Usage:
+ *    ./bench [<benchmark name filter>]
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "utf_8.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Test corpora.
+
+constexpr size_t CORPUS_SIZE{1 << 20};
+
+/**
+ * @brief A generated test corpus, both as UTF-8 and as the unicode values
+ * that the per character functions work with.
+ */
+struct Corpus
+{
+    std::string name{};
+    std::string utf8{};
+    std::vector<int> unicodes{};
+    std::u32string utf32{};
+    std::u16string utf16{};
+    std::string escaped{};
+};
+
+/**
+ * @brief Build a corpus from unicode values chosen by pick until it reaches
+ * CORPUS_SIZE bytes.
+ *
+ * @param name of the corpus.
+ * @param pick callable returning the next unicode value.
+ * @return Corpus the generated corpus.
+ */
+template<typename F>
+Corpus makeCorpus(const std::string & name, F pick)
+{
+    Corpus corpus{name};
+    while (corpus.utf8.length() < CORPUS_SIZE)
+    {
+        const int unicode{pick()};
+        corpus.utf8 += utf8::unicodeToUtf8(unicode);
+        corpus.unicodes.push_back(unicode);
+        corpus.utf32.push_back(unicode);
+    }
+
+    return corpus;
+}
+
+/**
+ * @brief Build a corpus of random bytes, many of which are not valid UTF-8.
+ * Invalid bytes are treated as ISO-8859-1 values for the unicode version.
+ *
+ * @param name of the corpus.
+ * @param random number generator.
+ * @return Corpus the generated corpus.
+ */
+Corpus makeMalformed(const std::string & name, std::mt19937 & random)
+{
+    std::uniform_int_distribution<int> byte{0, 255};
+
+    Corpus corpus{name};
+    corpus.utf8.reserve(CORPUS_SIZE);
+    while (corpus.utf8.length() < CORPUS_SIZE)
+        corpus.utf8 += (char)byte(random);
+
+    const std::string_view buffer{corpus.utf8};
+    for (size_t i{}; i < buffer.length(); )
+    {
+        int unicode{};
+        int length{};
+        if (!utf8::utf8ToUnicode(buffer.substr(i), unicode, length))
+        {
+            unicode = (unsigned char)buffer[i];
+            length = 1;
+        }
+
+        corpus.unicodes.push_back(unicode);
+        corpus.utf32.push_back(unicode);
+        i += length;
+    }
+
+    return corpus;
+}
+
+/**
+ * @brief Generate all the test corpora from a fixed seed, so that runs are
+ * comparable.
+ *
+ * @return std::vector<Corpus> the corpora.
+ */
+std::vector<Corpus> makeCorpora(void)
+{
+    std::mt19937 random{20261016};
+    std::uniform_int_distribution<int> ascii{0x20, 0x7E};
+    std::uniform_int_distribution<int> latin1{0xA0, 0xFF};
+    std::uniform_int_distribution<int> cjk{0x4E00, 0x9FFF};
+    std::uniform_int_distribution<int> emoji{0x1F300, 0x1F64F};
+    std::uniform_int_distribution<int> percent{0, 99};
+
+    std::vector<Corpus> corpora{};
+    corpora.push_back(makeCorpus("ascii", [&]() { return ascii(random); }));
+    corpora.push_back(makeCorpus("latin1", [&]() { return percent(random) < 30 ? latin1(random) : ascii(random); }));
+    corpora.push_back(makeCorpus("cjk", [&]() { return percent(random) < 10 ? ascii(random) : cjk(random); }));
+    corpora.push_back(makeCorpus("emoji", [&]() { return percent(random) < 20 ? 0x20 : emoji(random); }));
+    corpora.push_back(makeMalformed("malformed", random));
+
+    for (auto & corpus : corpora)
+        for (char32_t unicode : corpus.utf32)
+        {
+            if (unicode < 0x10000)
+                corpus.utf16.push_back(unicode);
+            else
+            {
+                corpus.utf16.push_back(0xD800 + ((unicode - 0x10000) >> 10));
+                corpus.utf16.push_back(0xDC00 + (unicode & 0x3FF));
+            }
+        }
+
+    // Every character that is not ASCII as a character reference.
+    for (auto & corpus : corpora)
+        corpus.escaped = utf8::escapeCopy(corpus.utf8, { .namedEntities = true, .asciiOnly = true });
+
+    return corpora;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Timing.
+
+/**
+ * @brief Results are accumulated here so that the benchmarked calls cannot
+ * be optimised away.
+ */
+volatile size_t sink{};
+
+/**
+ * @brief Determine the time for one call of func, taking the best average of
+ * several runs, each long enough to swamp the clock resolution.
+ *
+ * @param func callable to measure.
+ * @return double seconds per call.
+ */
+double measure(const std::function<void(void)> & func)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr double MIN_RUN{0.05};
+    constexpr int RUNS{5};
+
+    auto run = [&func](size_t iterations)
+    {
+        const auto start{Clock::now()};
+        for (size_t i{}; i < iterations; ++i)
+            func();
+
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    size_t iterations{1};
+    for (double elapsed{run(iterations)}; elapsed < MIN_RUN; elapsed = run(iterations))
+        iterations *= 2;
+
+    double best{run(iterations)};
+    for (int i{1}; i < RUNS; ++i)
+        best = std::min(best, run(iterations));
+
+    return best / iterations;
+}
+
+/**
+ * @brief A named benchmark, which processes the whole of a corpus per call.
+ */
+struct Benchmark
+{
+    std::string name;
+    std::function<void(const Corpus &)> func;
+};
+
+/**
+ * @brief Generate the list of benchmarks covering the public functions.
+ *
+ * @return std::vector<Benchmark> the benchmarks.
+ */
+std::vector<Benchmark> makeBenchmarks(void)
+{
+    static std::string work{};
+    static std::vector<char32_t> decoded(CORPUS_SIZE);
+    static std::vector<char16_t> wide(2 * CORPUS_SIZE);
+    static std::vector<char> encoded(utf8::caseCopyBound(CORPUS_SIZE + 4));
+
+    std::vector<Benchmark> benchmarks{};
+
+    benchmarks.push_back({"unicodeToUtf8", [](const Corpus & corpus)
+    {
+        for (auto unicode : corpus.unicodes)
+            sink = sink + utf8::unicodeToUtf8(unicode).length();
+    }});
+
+    benchmarks.push_back({"unicodeToUtf8Vector", [](const Corpus & corpus)
+    {
+        for (auto unicode : corpus.unicodes)
+            sink = sink + utf8::unicodeToUtf8Vector(unicode).size();
+    }});
+
+    benchmarks.push_back({"encode(char32_t)", [](const Corpus & corpus)
+    {
+        char bytes[4];
+        for (auto unicode : corpus.unicodes)
+            sink = sink + utf8::encode(unicode, bytes);
+    }});
+
+    benchmarks.push_back({"utf8ToUnicode", [](const Corpus & corpus)
+    {
+        const std::string_view buffer{corpus.utf8};
+        int unicode{};
+        int length{};
+        for (size_t i{}; i < buffer.length(); )
+            i += utf8::utf8ToUnicode(buffer.substr(i), unicode, length) ? length : 1;
+
+        sink = sink + unicode;
+    }});
+
+    benchmarks.push_back({"charCount", [](const Corpus & corpus)
+    {
+        sink = sink + utf8::charCount(corpus.utf8);
+    }});
+
+    benchmarks.push_back({"validate", [](const Corpus & corpus)
+    {
+        sink = sink + utf8::validate(corpus.utf8);
+    }});
+
+    benchmarks.push_back({"decode", [](const Corpus & corpus)
+    {
+        std::string_view buffer{corpus.utf8};
+        while (!buffer.empty())
+        {
+            const utf8::ConvertResult result{utf8::decode(buffer, decoded.data(), decoded.size())};
+            buffer.remove_prefix(result.consumed + (result.error == std::string_view::npos ? 0 : 1));
+            sink = sink + result.produced;
+        }
+    }});
+
+    benchmarks.push_back({"encode", [](const Corpus & corpus)
+    {
+        std::span<const char32_t> input{corpus.utf32};
+        while (!input.empty())
+        {
+            const utf8::ConvertResult result{utf8::encode(input, encoded.data(), encoded.size())};
+            input = input.subspan(result.consumed + (result.error == std::string_view::npos ? 0 : 1));
+            sink = sink + result.produced;
+        }
+    }});
+
+    benchmarks.push_back({"decode(char16_t)", [](const Corpus & corpus)
+    {
+        std::string_view buffer{corpus.utf8};
+        while (!buffer.empty())
+        {
+            const utf8::ConvertResult result{utf8::decode(buffer, wide.data(), wide.size())};
+            buffer.remove_prefix(result.consumed + (result.error == std::string_view::npos ? 0 : 1));
+            sink = sink + result.produced;
+        }
+    }});
+
+    benchmarks.push_back({"encode(char16_t)", [](const Corpus & corpus)
+    {
+        std::span<const char16_t> input{corpus.utf16};
+        while (!input.empty())
+        {
+            const utf8::ConvertResult result{utf8::encode(input, encoded.data(), encoded.size())};
+            input = input.subspan(result.consumed + (result.error == std::string_view::npos ? 0 : 1));
+            sink = sink + result.produced;
+        }
+    }});
+
+    benchmarks.push_back({"useCharacterRefs", [](const Corpus & corpus)
+    {
+        sink = sink + utf8::useCharacterRefs(corpus.utf8).length();
+    }});
+
+    benchmarks.push_back({"escapeCopy", [](const Corpus & corpus)
+    {
+        sink = sink + utf8::escapeCopy(corpus.utf8).length();
+    }});
+
+    benchmarks.push_back({"escapeCopy(asciiOnly)", [](const Corpus & corpus)
+    {
+        sink = sink + utf8::escapeCopy(corpus.utf8, { .asciiOnly = true }).length();
+    }});
+
+    benchmarks.push_back({"unescape", [](const Corpus & corpus)
+    {
+        sink = sink + utf8::unescapeCopy(corpus.escaped).length();
+    }});
+
+    benchmarks.push_back({"makeUpper", [](const Corpus & corpus)
+    {
+        work.assign(corpus.utf8);
+        utf8::makeUpper(work);
+        sink = sink + work.length();
+    }});
+
+    benchmarks.push_back({"makeLower", [](const Corpus & corpus)
+    {
+        work.assign(corpus.utf8);
+        utf8::makeLower(work);
+        sink = sink + work.length();
+    }});
+
+    benchmarks.push_back({"toUpperCopy", [](const Corpus & corpus)
+    {
+        sink = sink + (utf8::toUpperCopy(corpus.utf8, encoded.data()) - encoded.data());
+    }});
+
+    return benchmarks;
+}
+
+
+/**
+ * Run the benchmarks, optionally only those whose name contains the filter.
+ *
+ * @param  argc - command line argument count.
+ * @param  argv - command line argument vector.
+ * @return error value or 0 if no errors.
+ */
+int main(int argc, char *argv[])
+{
+    const std::string_view filter{(argc > 1) ? argv[1] : ""};
+
+    std::ofstream timings{"timings.txt"};
+    if (!timings)
+    {
+        std::cerr << "Unable to create timings.txt\n";
+
+        return 1;
+    }
+
+    timings << "# benchmark\tcorpus\tbytes\tcodepoints\tns_per_call\tmb_per_s\tcodepoints_per_s\n";
+    std::cout << std::left << std::setw(22) << "Benchmark" << std::setw(12) << "Corpus"
+        << std::right << std::setw(12) << "MB/s" << std::setw(16) << "Mcodepoints/s\n";
+
+    const std::vector<Corpus> corpora{makeCorpora()};
+    for (const auto & benchmark : makeBenchmarks())
+    {
+        if (benchmark.name.find(filter) == std::string::npos)
+            continue;
+
+        for (const auto & corpus : corpora)
+        {
+            const double seconds{measure([&]() { benchmark.func(corpus); })};
+            const double bytesPerSecond{corpus.utf8.length() / seconds};
+            const double codePointsPerSecond{corpus.unicodes.size() / seconds};
+
+            std::cout << std::left << std::setw(22) << benchmark.name << std::setw(12) << corpus.name
+                << std::right << std::fixed << std::setprecision(1)
+                << std::setw(12) << bytesPerSecond / 1e6 << std::setw(15) << codePointsPerSecond / 1e6 << "\n";
+
+            timings << benchmark.name << "\t" << corpus.name << "\t" << corpus.utf8.length() << "\t"
+                << corpus.unicodes.size() << "\t" << std::fixed << std::setprecision(0) << seconds * 1e9 << "\t"
+                << std::setprecision(1) << bytesPerSecond / 1e6 << "\t" << std::setprecision(0) << codePointsPerSecond << "\n";
+        }
+    }
+
+    return 0;
+}
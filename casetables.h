@@ -0,0 +1,980 @@
+/**
+ * @file    casetables.h
+ * @author  Phil Lockett <phillockett65@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Unicode 14.0.0 simple case mapping tables, generated by gencase.pl.
+ * Do not edit, regenerate using:
+ *    perl gencase.pl > casetables.h
+ *
+ * The mapping for a code point is found in two steps: caseIndex selects a
+ * block of 128 code points from caseBlocks, which selects an entry of
+ * caseDeltas holding the differences to the upper, lower and folded values.
+ * The entry flags also show which full mappings, to more than one code point,
+ * are held as UTF-8 in the sorted upperSpecials, lowerSpecials and
+ * foldSpecials tables.
+ */
+
+#if !defined(_CASETABLES_H__20261016_1015__INCLUDED_)
+#define _CASETABLES_H__20261016_1015__INCLUDED_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace utf8 {
+
+struct CaseDelta
+{
+    int32_t upper;
+    int32_t lower;
+    int32_t fold;
+    uint8_t special;
+};
+
+struct SpecialCase
+{
+    char32_t unicode;
+    uint8_t length;
+    char utf8[7];
+};
+
+constexpr uint8_t UPPER_SPECIAL{1};
+constexpr uint8_t LOWER_SPECIAL{2};
+constexpr uint8_t FOLD_SPECIAL{4};
+
+constexpr int caseBlockBits{7};
+constexpr char32_t caseLimit{125252};
+
+// No character expands to more than this many times its own UTF-8 length.
+constexpr size_t caseExpansion{3};
+
+constexpr uint8_t caseIndex[979]{
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 13, 12, 12, 12, 12, 12, 14, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 15, 16, 17, 18, 19, 20, 21,
+    12, 12, 22, 23, 12, 12, 12, 12, 12, 24, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 25, 26, 27, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 28, 29, 30, 31,
+    12, 12, 12, 12, 12, 12, 32, 33, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 34, 12, 12, 12, 12, 12, 12, 12, 35, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 36, 37, 38, 39, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 40, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 41, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 42, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12, 12, 43,
+};
+
+constexpr uint8_t caseBlocks[44][128]{
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0,
+        0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 0, 0, 0, 0, 0,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 4,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 2, 2, 0, 2, 2, 2, 2, 2, 2, 2, 5,
+    },
+    {
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        8, 9, 6, 7, 6, 7, 6, 7, 0, 6, 7, 6, 7, 6, 7, 6,
+        7, 6, 7, 6, 7, 6, 7, 6, 7, 4, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 10, 6, 7, 6, 7, 6, 7, 11,
+    },
+    {
+        12, 13, 6, 7, 6, 7, 14, 6, 7, 15, 15, 6, 7, 0, 16, 17,
+        18, 6, 7, 15, 19, 20, 21, 22, 6, 7, 23, 0, 21, 24, 25, 26,
+        6, 7, 6, 7, 6, 7, 27, 6, 7, 27, 0, 0, 6, 7, 27, 6,
+        7, 28, 28, 6, 7, 6, 7, 29, 6, 7, 0, 0, 6, 7, 0, 30,
+        0, 0, 0, 0, 31, 32, 33, 31, 32, 33, 31, 32, 33, 6, 7, 6,
+        7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 34, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        4, 31, 32, 33, 6, 7, 35, 36, 6, 7, 6, 7, 6, 7, 6, 7,
+    },
+    {
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        37, 0, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 0, 0, 0, 0, 0, 0, 38, 6, 7, 39, 40, 41,
+        41, 6, 7, 42, 43, 44, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        45, 46, 47, 48, 49, 0, 50, 50, 0, 51, 0, 52, 53, 0, 0, 0,
+        50, 54, 0, 55, 0, 56, 57, 0, 58, 59, 57, 60, 61, 0, 0, 59,
+        0, 62, 63, 0, 0, 64, 0, 0, 0, 0, 0, 0, 0, 65, 0, 0,
+    },
+    {
+        66, 0, 67, 66, 0, 0, 0, 68, 66, 69, 70, 70, 71, 0, 0, 0,
+        0, 0, 72, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 73, 74, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 75, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        6, 7, 6, 7, 0, 0, 6, 7, 0, 0, 0, 25, 25, 25, 0, 76,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 77, 0, 78, 78, 78, 0, 79, 0, 80, 80,
+        4, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 81, 82, 82, 82,
+        4, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 83, 2, 2, 2, 2, 2, 2, 2, 2, 2, 84, 85, 85, 86,
+        87, 88, 0, 0, 0, 89, 90, 91, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        92, 93, 94, 95, 96, 97, 0, 6, 7, 98, 6, 7, 0, 37, 37, 37,
+    },
+    {
+        99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+    },
+    {
+        6, 7, 0, 0, 0, 0, 0, 0, 0, 0, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        101, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 102,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+    },
+    {
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        0, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103,
+        103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103,
+        103, 103, 103, 103, 103, 103, 103, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+        104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+    },
+    {
+        104, 104, 104, 104, 104, 104, 104, 4, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105,
+        105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105, 105,
+        105, 105, 105, 105, 105, 105, 0, 105, 0, 0, 0, 0, 0, 105, 0, 0,
+        106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106,
+        106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106,
+        106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 106, 0, 0, 106, 106, 106,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107,
+        107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107,
+        107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107,
+        107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107,
+        107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107,
+        108, 108, 108, 108, 108, 108, 0, 0, 109, 109, 109, 109, 109, 109, 0, 0,
+    },
+    {
+        110, 111, 112, 113, 113, 114, 115, 116, 117, 0, 0, 0, 0, 0, 0, 0,
+        118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118,
+        118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118,
+        118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 118, 0, 0, 118, 118, 118,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 119, 0, 0, 0, 120, 0, 0,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 121, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+    },
+    {
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 4, 4, 4, 4, 4, 122, 0, 0, 123, 0,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+    },
+    {
+        124, 124, 124, 124, 124, 124, 124, 124, 125, 125, 125, 125, 125, 125, 125, 125,
+        124, 124, 124, 124, 124, 124, 0, 0, 125, 125, 125, 125, 125, 125, 0, 0,
+        124, 124, 124, 124, 124, 124, 124, 124, 125, 125, 125, 125, 125, 125, 125, 125,
+        124, 124, 124, 124, 124, 124, 124, 124, 125, 125, 125, 125, 125, 125, 125, 125,
+        124, 124, 124, 124, 124, 124, 0, 0, 125, 125, 125, 125, 125, 125, 0, 0,
+        4, 124, 4, 124, 4, 124, 4, 124, 0, 125, 0, 125, 0, 125, 0, 125,
+        124, 124, 124, 124, 124, 124, 124, 124, 125, 125, 125, 125, 125, 125, 125, 125,
+        126, 126, 127, 127, 127, 127, 128, 128, 129, 129, 130, 130, 131, 131, 0, 0,
+    },
+    {
+        132, 132, 132, 132, 132, 132, 132, 132, 133, 133, 133, 133, 133, 133, 133, 133,
+        132, 132, 132, 132, 132, 132, 132, 132, 133, 133, 133, 133, 133, 133, 133, 133,
+        132, 132, 132, 132, 132, 132, 132, 132, 133, 133, 133, 133, 133, 133, 133, 133,
+        124, 124, 4, 134, 4, 0, 4, 4, 125, 125, 135, 135, 136, 0, 137, 0,
+        0, 0, 4, 134, 4, 0, 4, 4, 138, 138, 138, 138, 136, 0, 0, 0,
+        124, 124, 4, 4, 0, 0, 4, 4, 125, 125, 139, 139, 0, 0, 0, 0,
+        124, 124, 4, 4, 4, 94, 4, 4, 125, 125, 140, 140, 98, 0, 0, 0,
+        0, 0, 4, 134, 4, 0, 4, 4, 141, 141, 142, 142, 136, 0, 0, 0,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 143, 0, 0, 0, 144, 145, 0, 0, 0, 0,
+        0, 0, 146, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 147, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148, 148,
+        149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149,
+    },
+    {
+        0, 0, 0, 6, 7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 150, 150, 150, 150, 150, 150, 150, 150, 150, 150,
+        150, 150, 150, 150, 150, 150, 150, 150, 150, 150, 150, 150, 150, 150, 150, 150,
+        151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 151,
+        151, 151, 151, 151, 151, 151, 151, 151, 151, 151, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103,
+        103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103,
+        103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103,
+        104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+        104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+        104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+        6, 7, 152, 153, 154, 155, 156, 6, 7, 6, 7, 6, 7, 157, 158, 159,
+        160, 0, 6, 7, 0, 6, 7, 0, 0, 0, 0, 0, 0, 0, 161, 161,
+    },
+    {
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 0, 0, 0, 0, 0, 0, 0, 6, 7, 6, 7, 0,
+        0, 0, 6, 7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162,
+        162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162, 162,
+        162, 162, 162, 162, 162, 162, 0, 162, 0, 0, 0, 0, 0, 162, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        0, 0, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 6, 7, 6, 7, 163, 6, 7,
+    },
+    {
+        6, 7, 6, 7, 6, 7, 6, 7, 0, 0, 0, 6, 7, 164, 0, 0,
+        6, 7, 6, 7, 165, 0, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 166, 167, 168, 169, 166, 0,
+        170, 171, 172, 173, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7,
+        6, 7, 6, 7, 174, 175, 176, 6, 7, 6, 7, 0, 0, 0, 0, 0,
+        6, 7, 0, 0, 0, 0, 6, 7, 6, 7, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 6, 7, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 177, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178,
+    },
+    {
+        178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178,
+        178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178,
+        178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178,
+        178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178, 178,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        4, 4, 4, 4, 4, 4, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 4, 4, 4, 4, 4, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0,
+        0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179,
+        179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179,
+        179, 179, 179, 179, 179, 179, 179, 179, 180, 180, 180, 180, 180, 180, 180, 180,
+        180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180,
+        180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179,
+        179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179,
+        179, 179, 179, 179, 0, 0, 0, 0, 180, 180, 180, 180, 180, 180, 180, 180,
+        180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180,
+        180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 0, 0, 0, 0,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 0, 181, 181, 181, 181,
+    },
+    {
+        181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 181, 0, 181, 181, 181, 181,
+        181, 181, 181, 0, 181, 181, 0, 182, 182, 182, 182, 182, 182, 182, 182, 182,
+        182, 182, 0, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182, 182,
+        182, 182, 0, 182, 182, 182, 182, 182, 182, 182, 0, 182, 182, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79,
+        79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79,
+        79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79,
+        79, 79, 79, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84,
+        84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84,
+        84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84, 84,
+        84, 84, 84, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    },
+    {
+        183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183,
+        183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183, 183,
+        183, 183, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184,
+        184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184, 184,
+        184, 184, 184, 184, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    },
+};
+
+constexpr CaseDelta caseDeltas[185]{
+    { 0, 0, 0, 0 },
+    { 0, 32, 32, 0 },
+    { -32, 0, 0, 0 },
+    { 743, 0, 775, 0 },
+    { 0, 0, 0, 5 },
+    { 121, 0, 0, 0 },
+    { 0, 1, 1, 0 },
+    { -1, 0, 0, 0 },
+    { 0, -199, 0, 6 },
+    { -232, 0, 0, 0 },
+    { 0, -121, -121, 0 },
+    { -300, 0, -268, 0 },
+    { 195, 0, 0, 0 },
+    { 0, 210, 210, 0 },
+    { 0, 206, 206, 0 },
+    { 0, 205, 205, 0 },
+    { 0, 79, 79, 0 },
+    { 0, 202, 202, 0 },
+    { 0, 203, 203, 0 },
+    { 0, 207, 207, 0 },
+    { 97, 0, 0, 0 },
+    { 0, 211, 211, 0 },
+    { 0, 209, 209, 0 },
+    { 163, 0, 0, 0 },
+    { 0, 213, 213, 0 },
+    { 130, 0, 0, 0 },
+    { 0, 214, 214, 0 },
+    { 0, 218, 218, 0 },
+    { 0, 217, 217, 0 },
+    { 0, 219, 219, 0 },
+    { 56, 0, 0, 0 },
+    { 0, 2, 2, 0 },
+    { -1, 1, 1, 0 },
+    { -2, 0, 0, 0 },
+    { -79, 0, 0, 0 },
+    { 0, -97, -97, 0 },
+    { 0, -56, -56, 0 },
+    { 0, -130, -130, 0 },
+    { 0, 10795, 10795, 0 },
+    { 0, -163, -163, 0 },
+    { 0, 10792, 10792, 0 },
+    { 10815, 0, 0, 0 },
+    { 0, -195, -195, 0 },
+    { 0, 69, 69, 0 },
+    { 0, 71, 71, 0 },
+    { 10783, 0, 0, 0 },
+    { 10780, 0, 0, 0 },
+    { 10782, 0, 0, 0 },
+    { -210, 0, 0, 0 },
+    { -206, 0, 0, 0 },
+    { -205, 0, 0, 0 },
+    { -202, 0, 0, 0 },
+    { -203, 0, 0, 0 },
+    { 42319, 0, 0, 0 },
+    { 42315, 0, 0, 0 },
+    { -207, 0, 0, 0 },
+    { 42280, 0, 0, 0 },
+    { 42308, 0, 0, 0 },
+    { -209, 0, 0, 0 },
+    { -211, 0, 0, 0 },
+    { 10743, 0, 0, 0 },
+    { 42305, 0, 0, 0 },
+    { 10749, 0, 0, 0 },
+    { -213, 0, 0, 0 },
+    { -214, 0, 0, 0 },
+    { 10727, 0, 0, 0 },
+    { -218, 0, 0, 0 },
+    { 42307, 0, 0, 0 },
+    { 42282, 0, 0, 0 },
+    { -69, 0, 0, 0 },
+    { -217, 0, 0, 0 },
+    { -71, 0, 0, 0 },
+    { -219, 0, 0, 0 },
+    { 42261, 0, 0, 0 },
+    { 42258, 0, 0, 0 },
+    { 84, 0, 116, 0 },
+    { 0, 116, 116, 0 },
+    { 0, 38, 38, 0 },
+    { 0, 37, 37, 0 },
+    { 0, 64, 64, 0 },
+    { 0, 63, 63, 0 },
+    { -38, 0, 0, 0 },
+    { -37, 0, 0, 0 },
+    { -31, 0, 1, 0 },
+    { -64, 0, 0, 0 },
+    { -63, 0, 0, 0 },
+    { 0, 8, 8, 0 },
+    { -62, 0, -30, 0 },
+    { -57, 0, -25, 0 },
+    { -47, 0, -15, 0 },
+    { -54, 0, -22, 0 },
+    { -8, 0, 0, 0 },
+    { -86, 0, -54, 0 },
+    { -80, 0, -48, 0 },
+    { 7, 0, 0, 0 },
+    { -116, 0, 0, 0 },
+    { 0, -60, -60, 0 },
+    { -96, 0, -64, 0 },
+    { 0, -7, -7, 0 },
+    { 0, 80, 80, 0 },
+    { -80, 0, 0, 0 },
+    { 0, 15, 15, 0 },
+    { -15, 0, 0, 0 },
+    { 0, 48, 48, 0 },
+    { -48, 0, 0, 0 },
+    { 0, 7264, 7264, 0 },
+    { 3008, 0, 0, 0 },
+    { 0, 38864, 0, 0 },
+    { 0, 8, 0, 0 },
+    { -8, 0, -8, 0 },
+    { -6254, 0, -6222, 0 },
+    { -6253, 0, -6221, 0 },
+    { -6244, 0, -6212, 0 },
+    { -6242, 0, -6210, 0 },
+    { -6243, 0, -6211, 0 },
+    { -6236, 0, -6204, 0 },
+    { -6181, 0, -6180, 0 },
+    { 35266, 0, 35267, 0 },
+    { 0, -3008, -3008, 0 },
+    { 35332, 0, 0, 0 },
+    { 3814, 0, 0, 0 },
+    { 35384, 0, 0, 0 },
+    { -59, 0, -58, 0 },
+    { 0, -7615, -7615, 4 },
+    { 8, 0, 0, 0 },
+    { 0, -8, -8, 0 },
+    { 74, 0, 0, 0 },
+    { 86, 0, 0, 0 },
+    { 100, 0, 0, 0 },
+    { 128, 0, 0, 0 },
+    { 112, 0, 0, 0 },
+    { 126, 0, 0, 0 },
+    { 8, 0, 0, 5 },
+    { 0, -8, -8, 5 },
+    { 9, 0, 0, 5 },
+    { 0, -74, -74, 0 },
+    { 0, -9, -9, 5 },
+    { -7205, 0, -7173, 0 },
+    { 0, -86, -86, 0 },
+    { 0, -100, -100, 0 },
+    { 0, -112, -112, 0 },
+    { 0, -128, -128, 0 },
+    { 0, -126, -126, 0 },
+    { 0, -7517, -7517, 0 },
+    { 0, -8383, -8383, 0 },
+    { 0, -8262, -8262, 0 },
+    { 0, 28, 28, 0 },
+    { -28, 0, 0, 0 },
+    { 0, 16, 16, 0 },
+    { -16, 0, 0, 0 },
+    { 0, 26, 26, 0 },
+    { -26, 0, 0, 0 },
+    { 0, -10743, -10743, 0 },
+    { 0, -3814, -3814, 0 },
+    { 0, -10727, -10727, 0 },
+    { -10795, 0, 0, 0 },
+    { -10792, 0, 0, 0 },
+    { 0, -10780, -10780, 0 },
+    { 0, -10749, -10749, 0 },
+    { 0, -10783, -10783, 0 },
+    { 0, -10782, -10782, 0 },
+    { 0, -10815, -10815, 0 },
+    { -7264, 0, 0, 0 },
+    { 0, -35332, -35332, 0 },
+    { 0, -42280, -42280, 0 },
+    { 48, 0, 0, 0 },
+    { 0, -42308, -42308, 0 },
+    { 0, -42319, -42319, 0 },
+    { 0, -42315, -42315, 0 },
+    { 0, -42305, -42305, 0 },
+    { 0, -42258, -42258, 0 },
+    { 0, -42282, -42282, 0 },
+    { 0, -42261, -42261, 0 },
+    { 0, 928, 928, 0 },
+    { 0, -48, -48, 0 },
+    { 0, -42307, -42307, 0 },
+    { 0, -35384, -35384, 0 },
+    { -928, 0, 0, 0 },
+    { -38864, 0, -38864, 0 },
+    { 0, 40, 40, 0 },
+    { -40, 0, 0, 0 },
+    { 0, 39, 39, 0 },
+    { -39, 0, 0, 0 },
+    { 0, 34, 34, 0 },
+    { -34, 0, 0, 0 },
+};
+
+constexpr SpecialCase upperSpecials[102]{
+    { 0x00DF, 2, "\x53\x53" },
+    { 0x0149, 3, "\xCA\xBC\x4E" },
+    { 0x01F0, 3, "\x4A\xCC\x8C" },
+    { 0x0390, 6, "\xCE\x99\xCC\x88\xCC\x81" },
+    { 0x03B0, 6, "\xCE\xA5\xCC\x88\xCC\x81" },
+    { 0x0587, 4, "\xD4\xB5\xD5\x92" },
+    { 0x1E96, 3, "\x48\xCC\xB1" },
+    { 0x1E97, 3, "\x54\xCC\x88" },
+    { 0x1E98, 3, "\x57\xCC\x8A" },
+    { 0x1E99, 3, "\x59\xCC\x8A" },
+    { 0x1E9A, 3, "\x41\xCA\xBE" },
+    { 0x1F50, 4, "\xCE\xA5\xCC\x93" },
+    { 0x1F52, 6, "\xCE\xA5\xCC\x93\xCC\x80" },
+    { 0x1F54, 6, "\xCE\xA5\xCC\x93\xCC\x81" },
+    { 0x1F56, 6, "\xCE\xA5\xCC\x93\xCD\x82" },
+    { 0x1F80, 5, "\xE1\xBC\x88\xCE\x99" },
+    { 0x1F81, 5, "\xE1\xBC\x89\xCE\x99" },
+    { 0x1F82, 5, "\xE1\xBC\x8A\xCE\x99" },
+    { 0x1F83, 5, "\xE1\xBC\x8B\xCE\x99" },
+    { 0x1F84, 5, "\xE1\xBC\x8C\xCE\x99" },
+    { 0x1F85, 5, "\xE1\xBC\x8D\xCE\x99" },
+    { 0x1F86, 5, "\xE1\xBC\x8E\xCE\x99" },
+    { 0x1F87, 5, "\xE1\xBC\x8F\xCE\x99" },
+    { 0x1F88, 5, "\xE1\xBC\x88\xCE\x99" },
+    { 0x1F89, 5, "\xE1\xBC\x89\xCE\x99" },
+    { 0x1F8A, 5, "\xE1\xBC\x8A\xCE\x99" },
+    { 0x1F8B, 5, "\xE1\xBC\x8B\xCE\x99" },
+    { 0x1F8C, 5, "\xE1\xBC\x8C\xCE\x99" },
+    { 0x1F8D, 5, "\xE1\xBC\x8D\xCE\x99" },
+    { 0x1F8E, 5, "\xE1\xBC\x8E\xCE\x99" },
+    { 0x1F8F, 5, "\xE1\xBC\x8F\xCE\x99" },
+    { 0x1F90, 5, "\xE1\xBC\xA8\xCE\x99" },
+    { 0x1F91, 5, "\xE1\xBC\xA9\xCE\x99" },
+    { 0x1F92, 5, "\xE1\xBC\xAA\xCE\x99" },
+    { 0x1F93, 5, "\xE1\xBC\xAB\xCE\x99" },
+    { 0x1F94, 5, "\xE1\xBC\xAC\xCE\x99" },
+    { 0x1F95, 5, "\xE1\xBC\xAD\xCE\x99" },
+    { 0x1F96, 5, "\xE1\xBC\xAE\xCE\x99" },
+    { 0x1F97, 5, "\xE1\xBC\xAF\xCE\x99" },
+    { 0x1F98, 5, "\xE1\xBC\xA8\xCE\x99" },
+    { 0x1F99, 5, "\xE1\xBC\xA9\xCE\x99" },
+    { 0x1F9A, 5, "\xE1\xBC\xAA\xCE\x99" },
+    { 0x1F9B, 5, "\xE1\xBC\xAB\xCE\x99" },
+    { 0x1F9C, 5, "\xE1\xBC\xAC\xCE\x99" },
+    { 0x1F9D, 5, "\xE1\xBC\xAD\xCE\x99" },
+    { 0x1F9E, 5, "\xE1\xBC\xAE\xCE\x99" },
+    { 0x1F9F, 5, "\xE1\xBC\xAF\xCE\x99" },
+    { 0x1FA0, 5, "\xE1\xBD\xA8\xCE\x99" },
+    { 0x1FA1, 5, "\xE1\xBD\xA9\xCE\x99" },
+    { 0x1FA2, 5, "\xE1\xBD\xAA\xCE\x99" },
+    { 0x1FA3, 5, "\xE1\xBD\xAB\xCE\x99" },
+    { 0x1FA4, 5, "\xE1\xBD\xAC\xCE\x99" },
+    { 0x1FA5, 5, "\xE1\xBD\xAD\xCE\x99" },
+    { 0x1FA6, 5, "\xE1\xBD\xAE\xCE\x99" },
+    { 0x1FA7, 5, "\xE1\xBD\xAF\xCE\x99" },
+    { 0x1FA8, 5, "\xE1\xBD\xA8\xCE\x99" },
+    { 0x1FA9, 5, "\xE1\xBD\xA9\xCE\x99" },
+    { 0x1FAA, 5, "\xE1\xBD\xAA\xCE\x99" },
+    { 0x1FAB, 5, "\xE1\xBD\xAB\xCE\x99" },
+    { 0x1FAC, 5, "\xE1\xBD\xAC\xCE\x99" },
+    { 0x1FAD, 5, "\xE1\xBD\xAD\xCE\x99" },
+    { 0x1FAE, 5, "\xE1\xBD\xAE\xCE\x99" },
+    { 0x1FAF, 5, "\xE1\xBD\xAF\xCE\x99" },
+    { 0x1FB2, 5, "\xE1\xBE\xBA\xCE\x99" },
+    { 0x1FB3, 4, "\xCE\x91\xCE\x99" },
+    { 0x1FB4, 4, "\xCE\x86\xCE\x99" },
+    { 0x1FB6, 4, "\xCE\x91\xCD\x82" },
+    { 0x1FB7, 6, "\xCE\x91\xCD\x82\xCE\x99" },
+    { 0x1FBC, 4, "\xCE\x91\xCE\x99" },
+    { 0x1FC2, 5, "\xE1\xBF\x8A\xCE\x99" },
+    { 0x1FC3, 4, "\xCE\x97\xCE\x99" },
+    { 0x1FC4, 4, "\xCE\x89\xCE\x99" },
+    { 0x1FC6, 4, "\xCE\x97\xCD\x82" },
+    { 0x1FC7, 6, "\xCE\x97\xCD\x82\xCE\x99" },
+    { 0x1FCC, 4, "\xCE\x97\xCE\x99" },
+    { 0x1FD2, 6, "\xCE\x99\xCC\x88\xCC\x80" },
+    { 0x1FD3, 6, "\xCE\x99\xCC\x88\xCC\x81" },
+    { 0x1FD6, 4, "\xCE\x99\xCD\x82" },
+    { 0x1FD7, 6, "\xCE\x99\xCC\x88\xCD\x82" },
+    { 0x1FE2, 6, "\xCE\xA5\xCC\x88\xCC\x80" },
+    { 0x1FE3, 6, "\xCE\xA5\xCC\x88\xCC\x81" },
+    { 0x1FE4, 4, "\xCE\xA1\xCC\x93" },
+    { 0x1FE6, 4, "\xCE\xA5\xCD\x82" },
+    { 0x1FE7, 6, "\xCE\xA5\xCC\x88\xCD\x82" },
+    { 0x1FF2, 5, "\xE1\xBF\xBA\xCE\x99" },
+    { 0x1FF3, 4, "\xCE\xA9\xCE\x99" },
+    { 0x1FF4, 4, "\xCE\x8F\xCE\x99" },
+    { 0x1FF6, 4, "\xCE\xA9\xCD\x82" },
+    { 0x1FF7, 6, "\xCE\xA9\xCD\x82\xCE\x99" },
+    { 0x1FFC, 4, "\xCE\xA9\xCE\x99" },
+    { 0xFB00, 2, "\x46\x46" },
+    { 0xFB01, 2, "\x46\x49" },
+    { 0xFB02, 2, "\x46\x4C" },
+    { 0xFB03, 3, "\x46\x46\x49" },
+    { 0xFB04, 3, "\x46\x46\x4C" },
+    { 0xFB05, 2, "\x53\x54" },
+    { 0xFB06, 2, "\x53\x54" },
+    { 0xFB13, 4, "\xD5\x84\xD5\x86" },
+    { 0xFB14, 4, "\xD5\x84\xD4\xB5" },
+    { 0xFB15, 4, "\xD5\x84\xD4\xBB" },
+    { 0xFB16, 4, "\xD5\x8E\xD5\x86" },
+    { 0xFB17, 4, "\xD5\x84\xD4\xBD" },
+};
+
+constexpr SpecialCase lowerSpecials[1]{
+    { 0x0130, 3, "\x69\xCC\x87" },
+};
+
+constexpr SpecialCase foldSpecials[104]{
+    { 0x00DF, 2, "\x73\x73" },
+    { 0x0130, 3, "\x69\xCC\x87" },
+    { 0x0149, 3, "\xCA\xBC\x6E" },
+    { 0x01F0, 3, "\x6A\xCC\x8C" },
+    { 0x0390, 6, "\xCE\xB9\xCC\x88\xCC\x81" },
+    { 0x03B0, 6, "\xCF\x85\xCC\x88\xCC\x81" },
+    { 0x0587, 4, "\xD5\xA5\xD6\x82" },
+    { 0x1E96, 3, "\x68\xCC\xB1" },
+    { 0x1E97, 3, "\x74\xCC\x88" },
+    { 0x1E98, 3, "\x77\xCC\x8A" },
+    { 0x1E99, 3, "\x79\xCC\x8A" },
+    { 0x1E9A, 3, "\x61\xCA\xBE" },
+    { 0x1E9E, 2, "\x73\x73" },
+    { 0x1F50, 4, "\xCF\x85\xCC\x93" },
+    { 0x1F52, 6, "\xCF\x85\xCC\x93\xCC\x80" },
+    { 0x1F54, 6, "\xCF\x85\xCC\x93\xCC\x81" },
+    { 0x1F56, 6, "\xCF\x85\xCC\x93\xCD\x82" },
+    { 0x1F80, 5, "\xE1\xBC\x80\xCE\xB9" },
+    { 0x1F81, 5, "\xE1\xBC\x81\xCE\xB9" },
+    { 0x1F82, 5, "\xE1\xBC\x82\xCE\xB9" },
+    { 0x1F83, 5, "\xE1\xBC\x83\xCE\xB9" },
+    { 0x1F84, 5, "\xE1\xBC\x84\xCE\xB9" },
+    { 0x1F85, 5, "\xE1\xBC\x85\xCE\xB9" },
+    { 0x1F86, 5, "\xE1\xBC\x86\xCE\xB9" },
+    { 0x1F87, 5, "\xE1\xBC\x87\xCE\xB9" },
+    { 0x1F88, 5, "\xE1\xBC\x80\xCE\xB9" },
+    { 0x1F89, 5, "\xE1\xBC\x81\xCE\xB9" },
+    { 0x1F8A, 5, "\xE1\xBC\x82\xCE\xB9" },
+    { 0x1F8B, 5, "\xE1\xBC\x83\xCE\xB9" },
+    { 0x1F8C, 5, "\xE1\xBC\x84\xCE\xB9" },
+    { 0x1F8D, 5, "\xE1\xBC\x85\xCE\xB9" },
+    { 0x1F8E, 5, "\xE1\xBC\x86\xCE\xB9" },
+    { 0x1F8F, 5, "\xE1\xBC\x87\xCE\xB9" },
+    { 0x1F90, 5, "\xE1\xBC\xA0\xCE\xB9" },
+    { 0x1F91, 5, "\xE1\xBC\xA1\xCE\xB9" },
+    { 0x1F92, 5, "\xE1\xBC\xA2\xCE\xB9" },
+    { 0x1F93, 5, "\xE1\xBC\xA3\xCE\xB9" },
+    { 0x1F94, 5, "\xE1\xBC\xA4\xCE\xB9" },
+    { 0x1F95, 5, "\xE1\xBC\xA5\xCE\xB9" },
+    { 0x1F96, 5, "\xE1\xBC\xA6\xCE\xB9" },
+    { 0x1F97, 5, "\xE1\xBC\xA7\xCE\xB9" },
+    { 0x1F98, 5, "\xE1\xBC\xA0\xCE\xB9" },
+    { 0x1F99, 5, "\xE1\xBC\xA1\xCE\xB9" },
+    { 0x1F9A, 5, "\xE1\xBC\xA2\xCE\xB9" },
+    { 0x1F9B, 5, "\xE1\xBC\xA3\xCE\xB9" },
+    { 0x1F9C, 5, "\xE1\xBC\xA4\xCE\xB9" },
+    { 0x1F9D, 5, "\xE1\xBC\xA5\xCE\xB9" },
+    { 0x1F9E, 5, "\xE1\xBC\xA6\xCE\xB9" },
+    { 0x1F9F, 5, "\xE1\xBC\xA7\xCE\xB9" },
+    { 0x1FA0, 5, "\xE1\xBD\xA0\xCE\xB9" },
+    { 0x1FA1, 5, "\xE1\xBD\xA1\xCE\xB9" },
+    { 0x1FA2, 5, "\xE1\xBD\xA2\xCE\xB9" },
+    { 0x1FA3, 5, "\xE1\xBD\xA3\xCE\xB9" },
+    { 0x1FA4, 5, "\xE1\xBD\xA4\xCE\xB9" },
+    { 0x1FA5, 5, "\xE1\xBD\xA5\xCE\xB9" },
+    { 0x1FA6, 5, "\xE1\xBD\xA6\xCE\xB9" },
+    { 0x1FA7, 5, "\xE1\xBD\xA7\xCE\xB9" },
+    { 0x1FA8, 5, "\xE1\xBD\xA0\xCE\xB9" },
+    { 0x1FA9, 5, "\xE1\xBD\xA1\xCE\xB9" },
+    { 0x1FAA, 5, "\xE1\xBD\xA2\xCE\xB9" },
+    { 0x1FAB, 5, "\xE1\xBD\xA3\xCE\xB9" },
+    { 0x1FAC, 5, "\xE1\xBD\xA4\xCE\xB9" },
+    { 0x1FAD, 5, "\xE1\xBD\xA5\xCE\xB9" },
+    { 0x1FAE, 5, "\xE1\xBD\xA6\xCE\xB9" },
+    { 0x1FAF, 5, "\xE1\xBD\xA7\xCE\xB9" },
+    { 0x1FB2, 5, "\xE1\xBD\xB0\xCE\xB9" },
+    { 0x1FB3, 4, "\xCE\xB1\xCE\xB9" },
+    { 0x1FB4, 4, "\xCE\xAC\xCE\xB9" },
+    { 0x1FB6, 4, "\xCE\xB1\xCD\x82" },
+    { 0x1FB7, 6, "\xCE\xB1\xCD\x82\xCE\xB9" },
+    { 0x1FBC, 4, "\xCE\xB1\xCE\xB9" },
+    { 0x1FC2, 5, "\xE1\xBD\xB4\xCE\xB9" },
+    { 0x1FC3, 4, "\xCE\xB7\xCE\xB9" },
+    { 0x1FC4, 4, "\xCE\xAE\xCE\xB9" },
+    { 0x1FC6, 4, "\xCE\xB7\xCD\x82" },
+    { 0x1FC7, 6, "\xCE\xB7\xCD\x82\xCE\xB9" },
+    { 0x1FCC, 4, "\xCE\xB7\xCE\xB9" },
+    { 0x1FD2, 6, "\xCE\xB9\xCC\x88\xCC\x80" },
+    { 0x1FD3, 6, "\xCE\xB9\xCC\x88\xCC\x81" },
+    { 0x1FD6, 4, "\xCE\xB9\xCD\x82" },
+    { 0x1FD7, 6, "\xCE\xB9\xCC\x88\xCD\x82" },
+    { 0x1FE2, 6, "\xCF\x85\xCC\x88\xCC\x80" },
+    { 0x1FE3, 6, "\xCF\x85\xCC\x88\xCC\x81" },
+    { 0x1FE4, 4, "\xCF\x81\xCC\x93" },
+    { 0x1FE6, 4, "\xCF\x85\xCD\x82" },
+    { 0x1FE7, 6, "\xCF\x85\xCC\x88\xCD\x82" },
+    { 0x1FF2, 5, "\xE1\xBD\xBC\xCE\xB9" },
+    { 0x1FF3, 4, "\xCF\x89\xCE\xB9" },
+    { 0x1FF4, 4, "\xCF\x8E\xCE\xB9" },
+    { 0x1FF6, 4, "\xCF\x89\xCD\x82" },
+    { 0x1FF7, 6, "\xCF\x89\xCD\x82\xCE\xB9" },
+    { 0x1FFC, 4, "\xCF\x89\xCE\xB9" },
+    { 0xFB00, 2, "\x66\x66" },
+    { 0xFB01, 2, "\x66\x69" },
+    { 0xFB02, 2, "\x66\x6C" },
+    { 0xFB03, 3, "\x66\x66\x69" },
+    { 0xFB04, 3, "\x66\x66\x6C" },
+    { 0xFB05, 2, "\x73\x74" },
+    { 0xFB06, 2, "\x73\x74" },
+    { 0xFB13, 4, "\xD5\xB4\xD5\xB6" },
+    { 0xFB14, 4, "\xD5\xB4\xD5\xA5" },
+    { 0xFB15, 4, "\xD5\xB4\xD5\xAB" },
+    { 0xFB16, 4, "\xD5\xBE\xD5\xB6" },
+    { 0xFB17, 4, "\xD5\xB4\xD5\xAD" },
+};
+
+}   // end namespace
+
+#endif // !defined(_CASETABLES_H__20261016_1015__INCLUDED_)
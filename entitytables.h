@@ -0,0 +1,362 @@
+/**
+ * @file    entitytables.h
+ * @author  Phil Lockett <phillockett65@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * HTML 4.01 named character reference table, plus the XML apos, generated by
+ * genentities.pl.
+ * Do not edit, regenerate using:
+ *    perl genentities.pl > entitytables.h
+ *
+ * The entities table is sorted by code point so the name for a character can
+ * be found with a binary search. The character for a name is found with a
+ * perfect hash: entityHash() with seed 0 selects an entry of entitySeeds,
+ * giving the seed for entityHash() to select an entry of entitySlots, holding
+ * one more than the index of the only name that can match, or 0 for none.
+ */
+
+#if !defined(_ENTITYTABLES_H__20261016_1400__INCLUDED_)
+#define _ENTITYTABLES_H__20261016_1400__INCLUDED_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace utf8 {
+
+struct Entity
+{
+    char32_t unicode;
+    uint8_t length;
+    char name[9];
+};
+
+// No entity name is longer than this.
+constexpr size_t entityNameMax{8};
+
+constexpr Entity entities[253]{
+    { 0x0022, 4, "quot" },
+    { 0x0026, 3, "amp" },
+    { 0x0027, 4, "apos" },
+    { 0x003C, 2, "lt" },
+    { 0x003E, 2, "gt" },
+    { 0x00A0, 4, "nbsp" },
+    { 0x00A1, 5, "iexcl" },
+    { 0x00A2, 4, "cent" },
+    { 0x00A3, 5, "pound" },
+    { 0x00A4, 6, "curren" },
+    { 0x00A5, 3, "yen" },
+    { 0x00A6, 6, "brvbar" },
+    { 0x00A7, 4, "sect" },
+    { 0x00A8, 3, "uml" },
+    { 0x00A9, 4, "copy" },
+    { 0x00AA, 4, "ordf" },
+    { 0x00AB, 5, "laquo" },
+    { 0x00AC, 3, "not" },
+    { 0x00AD, 3, "shy" },
+    { 0x00AE, 3, "reg" },
+    { 0x00AF, 4, "macr" },
+    { 0x00B0, 3, "deg" },
+    { 0x00B1, 6, "plusmn" },
+    { 0x00B2, 4, "sup2" },
+    { 0x00B3, 4, "sup3" },
+    { 0x00B4, 5, "acute" },
+    { 0x00B5, 5, "micro" },
+    { 0x00B6, 4, "para" },
+    { 0x00B7, 6, "middot" },
+    { 0x00B8, 5, "cedil" },
+    { 0x00B9, 4, "sup1" },
+    { 0x00BA, 4, "ordm" },
+    { 0x00BB, 5, "raquo" },
+    { 0x00BC, 6, "frac14" },
+    { 0x00BD, 6, "frac12" },
+    { 0x00BE, 6, "frac34" },
+    { 0x00BF, 6, "iquest" },
+    { 0x00C0, 6, "Agrave" },
+    { 0x00C1, 6, "Aacute" },
+    { 0x00C2, 5, "Acirc" },
+    { 0x00C3, 6, "Atilde" },
+    { 0x00C4, 4, "Auml" },
+    { 0x00C5, 5, "Aring" },
+    { 0x00C6, 5, "AElig" },
+    { 0x00C7, 6, "Ccedil" },
+    { 0x00C8, 6, "Egrave" },
+    { 0x00C9, 6, "Eacute" },
+    { 0x00CA, 5, "Ecirc" },
+    { 0x00CB, 4, "Euml" },
+    { 0x00CC, 6, "Igrave" },
+    { 0x00CD, 6, "Iacute" },
+    { 0x00CE, 5, "Icirc" },
+    { 0x00CF, 4, "Iuml" },
+    { 0x00D0, 3, "ETH" },
+    { 0x00D1, 6, "Ntilde" },
+    { 0x00D2, 6, "Ograve" },
+    { 0x00D3, 6, "Oacute" },
+    { 0x00D4, 5, "Ocirc" },
+    { 0x00D5, 6, "Otilde" },
+    { 0x00D6, 4, "Ouml" },
+    { 0x00D7, 5, "times" },
+    { 0x00D8, 6, "Oslash" },
+    { 0x00D9, 6, "Ugrave" },
+    { 0x00DA, 6, "Uacute" },
+    { 0x00DB, 5, "Ucirc" },
+    { 0x00DC, 4, "Uuml" },
+    { 0x00DD, 6, "Yacute" },
+    { 0x00DE, 5, "THORN" },
+    { 0x00DF, 5, "szlig" },
+    { 0x00E0, 6, "agrave" },
+    { 0x00E1, 6, "aacute" },
+    { 0x00E2, 5, "acirc" },
+    { 0x00E3, 6, "atilde" },
+    { 0x00E4, 4, "auml" },
+    { 0x00E5, 5, "aring" },
+    { 0x00E6, 5, "aelig" },
+    { 0x00E7, 6, "ccedil" },
+    { 0x00E8, 6, "egrave" },
+    { 0x00E9, 6, "eacute" },
+    { 0x00EA, 5, "ecirc" },
+    { 0x00EB, 4, "euml" },
+    { 0x00EC, 6, "igrave" },
+    { 0x00ED, 6, "iacute" },
+    { 0x00EE, 5, "icirc" },
+    { 0x00EF, 4, "iuml" },
+    { 0x00F0, 3, "eth" },
+    { 0x00F1, 6, "ntilde" },
+    { 0x00F2, 6, "ograve" },
+    { 0x00F3, 6, "oacute" },
+    { 0x00F4, 5, "ocirc" },
+    { 0x00F5, 6, "otilde" },
+    { 0x00F6, 4, "ouml" },
+    { 0x00F7, 6, "divide" },
+    { 0x00F8, 6, "oslash" },
+    { 0x00F9, 6, "ugrave" },
+    { 0x00FA, 6, "uacute" },
+    { 0x00FB, 5, "ucirc" },
+    { 0x00FC, 4, "uuml" },
+    { 0x00FD, 6, "yacute" },
+    { 0x00FE, 5, "thorn" },
+    { 0x00FF, 4, "yuml" },
+    { 0x0152, 5, "OElig" },
+    { 0x0153, 5, "oelig" },
+    { 0x0160, 6, "Scaron" },
+    { 0x0161, 6, "scaron" },
+    { 0x0178, 4, "Yuml" },
+    { 0x0192, 4, "fnof" },
+    { 0x02C6, 4, "circ" },
+    { 0x02DC, 5, "tilde" },
+    { 0x0391, 5, "Alpha" },
+    { 0x0392, 4, "Beta" },
+    { 0x0393, 5, "Gamma" },
+    { 0x0394, 5, "Delta" },
+    { 0x0395, 7, "Epsilon" },
+    { 0x0396, 4, "Zeta" },
+    { 0x0397, 3, "Eta" },
+    { 0x0398, 5, "Theta" },
+    { 0x0399, 4, "Iota" },
+    { 0x039A, 5, "Kappa" },
+    { 0x039B, 6, "Lambda" },
+    { 0x039C, 2, "Mu" },
+    { 0x039D, 2, "Nu" },
+    { 0x039E, 2, "Xi" },
+    { 0x039F, 7, "Omicron" },
+    { 0x03A0, 2, "Pi" },
+    { 0x03A1, 3, "Rho" },
+    { 0x03A3, 5, "Sigma" },
+    { 0x03A4, 3, "Tau" },
+    { 0x03A5, 7, "Upsilon" },
+    { 0x03A6, 3, "Phi" },
+    { 0x03A7, 3, "Chi" },
+    { 0x03A8, 3, "Psi" },
+    { 0x03A9, 5, "Omega" },
+    { 0x03B1, 5, "alpha" },
+    { 0x03B2, 4, "beta" },
+    { 0x03B3, 5, "gamma" },
+    { 0x03B4, 5, "delta" },
+    { 0x03B5, 7, "epsilon" },
+    { 0x03B6, 4, "zeta" },
+    { 0x03B7, 3, "eta" },
+    { 0x03B8, 5, "theta" },
+    { 0x03B9, 4, "iota" },
+    { 0x03BA, 5, "kappa" },
+    { 0x03BB, 6, "lambda" },
+    { 0x03BC, 2, "mu" },
+    { 0x03BD, 2, "nu" },
+    { 0x03BE, 2, "xi" },
+    { 0x03BF, 7, "omicron" },
+    { 0x03C0, 2, "pi" },
+    { 0x03C1, 3, "rho" },
+    { 0x03C2, 6, "sigmaf" },
+    { 0x03C3, 5, "sigma" },
+    { 0x03C4, 3, "tau" },
+    { 0x03C5, 7, "upsilon" },
+    { 0x03C6, 3, "phi" },
+    { 0x03C7, 3, "chi" },
+    { 0x03C8, 3, "psi" },
+    { 0x03C9, 5, "omega" },
+    { 0x03D1, 8, "thetasym" },
+    { 0x03D2, 5, "upsih" },
+    { 0x03D6, 3, "piv" },
+    { 0x2002, 4, "ensp" },
+    { 0x2003, 4, "emsp" },
+    { 0x2009, 6, "thinsp" },
+    { 0x200C, 4, "zwnj" },
+    { 0x200D, 3, "zwj" },
+    { 0x200E, 3, "lrm" },
+    { 0x200F, 3, "rlm" },
+    { 0x2013, 5, "ndash" },
+    { 0x2014, 5, "mdash" },
+    { 0x2018, 5, "lsquo" },
+    { 0x2019, 5, "rsquo" },
+    { 0x201A, 5, "sbquo" },
+    { 0x201C, 5, "ldquo" },
+    { 0x201D, 5, "rdquo" },
+    { 0x201E, 5, "bdquo" },
+    { 0x2020, 6, "dagger" },
+    { 0x2021, 6, "Dagger" },
+    { 0x2022, 4, "bull" },
+    { 0x2026, 6, "hellip" },
+    { 0x2030, 6, "permil" },
+    { 0x2032, 5, "prime" },
+    { 0x2033, 5, "Prime" },
+    { 0x2039, 6, "lsaquo" },
+    { 0x203A, 6, "rsaquo" },
+    { 0x203E, 5, "oline" },
+    { 0x2044, 5, "frasl" },
+    { 0x20AC, 4, "euro" },
+    { 0x2111, 5, "image" },
+    { 0x2118, 6, "weierp" },
+    { 0x211C, 4, "real" },
+    { 0x2122, 5, "trade" },
+    { 0x2135, 7, "alefsym" },
+    { 0x2190, 4, "larr" },
+    { 0x2191, 4, "uarr" },
+    { 0x2192, 4, "rarr" },
+    { 0x2193, 4, "darr" },
+    { 0x2194, 4, "harr" },
+    { 0x21B5, 5, "crarr" },
+    { 0x21D0, 4, "lArr" },
+    { 0x21D1, 4, "uArr" },
+    { 0x21D2, 4, "rArr" },
+    { 0x21D3, 4, "dArr" },
+    { 0x21D4, 4, "hArr" },
+    { 0x2200, 6, "forall" },
+    { 0x2202, 4, "part" },
+    { 0x2203, 5, "exist" },
+    { 0x2205, 5, "empty" },
+    { 0x2207, 5, "nabla" },
+    { 0x2208, 4, "isin" },
+    { 0x2209, 5, "notin" },
+    { 0x220B, 2, "ni" },
+    { 0x220F, 4, "prod" },
+    { 0x2211, 3, "sum" },
+    { 0x2212, 5, "minus" },
+    { 0x2217, 6, "lowast" },
+    { 0x221A, 5, "radic" },
+    { 0x221D, 4, "prop" },
+    { 0x221E, 5, "infin" },
+    { 0x2220, 3, "ang" },
+    { 0x2227, 3, "and" },
+    { 0x2228, 2, "or" },
+    { 0x2229, 3, "cap" },
+    { 0x222A, 3, "cup" },
+    { 0x222B, 3, "int" },
+    { 0x2234, 6, "there4" },
+    { 0x223C, 3, "sim" },
+    { 0x2245, 4, "cong" },
+    { 0x2248, 5, "asymp" },
+    { 0x2260, 2, "ne" },
+    { 0x2261, 5, "equiv" },
+    { 0x2264, 2, "le" },
+    { 0x2265, 2, "ge" },
+    { 0x2282, 3, "sub" },
+    { 0x2283, 3, "sup" },
+    { 0x2284, 4, "nsub" },
+    { 0x2286, 4, "sube" },
+    { 0x2287, 4, "supe" },
+    { 0x2295, 5, "oplus" },
+    { 0x2297, 6, "otimes" },
+    { 0x22A5, 4, "perp" },
+    { 0x22C5, 4, "sdot" },
+    { 0x2308, 5, "lceil" },
+    { 0x2309, 5, "rceil" },
+    { 0x230A, 6, "lfloor" },
+    { 0x230B, 6, "rfloor" },
+    { 0x2329, 4, "lang" },
+    { 0x232A, 4, "rang" },
+    { 0x25CA, 3, "loz" },
+    { 0x2660, 6, "spades" },
+    { 0x2663, 5, "clubs" },
+    { 0x2665, 6, "hearts" },
+    { 0x2666, 5, "diams" },
+};
+
+constexpr size_t entityBuckets{128};
+constexpr size_t entitySlotCount{256};
+
+/**
+ * @brief FNV-1a hash of an entity name, varied by a seed.
+ * 
+ * @param name of the entity, without the '&' and ';'.
+ * @param length of the name.
+ * @param seed to vary the hash by.
+ * @return uint32_t the hash value.
+ */
+constexpr uint32_t entityHash(const char * name, size_t length, uint32_t seed)
+{
+    uint32_t hash{2166136261u ^ seed};
+    for (size_t i{}; i < length; ++i)
+    {
+        hash ^= (unsigned char)name[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+constexpr uint8_t entitySeeds[128]{
+    1, 0, 19, 0, 1, 4, 38, 3, 2, 8, 1, 6, 3, 6, 16, 3,
+    38, 0, 2, 1, 3, 2, 1, 2, 1, 3, 7, 5, 3, 24, 4, 7,
+    12, 10, 2, 36, 10, 0, 1, 5, 1, 28, 7, 10, 34, 7, 1, 1,
+    16, 11, 4, 3, 4, 4, 0, 7, 0, 0, 40, 5, 1, 29, 14, 4,
+    1, 21, 24, 16, 1, 19, 13, 1, 7, 1, 5, 10, 1, 35, 18, 7,
+    13, 11, 2, 61, 0, 10, 8, 11, 8, 3, 7, 2, 0, 7, 8, 9,
+    0, 0, 0, 2, 6, 58, 10, 2, 33, 26, 5, 0, 0, 11, 1, 0,
+    11, 0, 23, 5, 14, 22, 38, 45, 2, 0, 2, 0, 31, 68, 89, 0,
+};
+
+constexpr uint8_t entitySlots[256]{
+    98, 64, 143, 66, 49, 148, 169, 244, 186, 203, 218, 0, 116, 54, 95, 247,
+    44, 121, 94, 12, 117, 109, 135, 158, 14, 131, 107, 20, 200, 232, 145, 206,
+    52, 230, 213, 73, 23, 221, 177, 19, 102, 56, 69, 235, 129, 92, 63, 1,
+    242, 159, 55, 201, 106, 18, 164, 214, 171, 226, 175, 9, 168, 194, 13, 193,
+    108, 231, 170, 99, 32, 208, 212, 41, 97, 30, 188, 48, 46, 227, 3, 217,
+    76, 110, 191, 50, 125, 0, 62, 137, 37, 178, 122, 161, 189, 75, 150, 153,
+    43, 128, 130, 154, 199, 138, 115, 105, 103, 207, 25, 112, 220, 40, 91, 10,
+    185, 47, 114, 74, 141, 89, 4, 146, 77, 222, 45, 36, 167, 33, 151, 181,
+    249, 241, 24, 174, 192, 127, 16, 195, 6, 86, 224, 184, 27, 237, 65, 238,
+    118, 209, 246, 124, 197, 51, 113, 79, 58, 202, 11, 182, 83, 53, 162, 239,
+    26, 180, 233, 229, 243, 7, 173, 211, 5, 166, 67, 144, 172, 39, 190, 21,
+    176, 134, 57, 248, 100, 228, 163, 120, 2, 28, 68, 93, 183, 149, 35, 204,
+    34, 132, 236, 126, 250, 179, 60, 78, 223, 15, 165, 234, 215, 72, 71, 119,
+    140, 61, 160, 31, 87, 216, 225, 82, 253, 133, 187, 0, 198, 59, 80, 17,
+    252, 240, 96, 210, 85, 147, 152, 156, 84, 205, 81, 139, 219, 29, 196, 155,
+    8, 142, 70, 123, 245, 136, 22, 251, 90, 101, 38, 104, 157, 111, 88, 42,
+};
+
+}   // end namespace
+
+#endif // !defined(_ENTITYTABLES_H__20261016_1400__INCLUDED_)
@@ -0,0 +1,283 @@
+#!/usr/bin/perl
+#
+# @file    gencase.pl
+# @author  Phil Lockett <phillockett65@gmail.com>
+# @version 1.0
+#
+# @section LICENSE
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License as
+# published by the Free Software Foundation; either version 2 of
+# the License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+# General Public License for more details at
+# https://www.gnu.org/copyleft/gpl.html
+#
+# @section DESCRIPTION
+#
+# Generate casetables.h, the two level Unicode case mapping tables, from the
+# Unicode Character Database that ships with Perl.
+#
+# Usage:
+#    perl gencase.pl > casetables.h
+#
+
+use strict;
+use warnings;
+use Unicode::UCD qw(prop_invmap);
+
+my $BLOCK_BITS = 7;
+my $BLOCK_SIZE = 1 << $BLOCK_BITS;
+
+# Expand an "a" format inversion map into a hash of code point => delta.
+sub deltas
+{
+    my ($property) = @_;
+    my ($list, $map, $format) = prop_invmap($property);
+    die "Unexpected format $format for $property\n" unless $format eq 'a';
+
+    my %delta;
+    for my $i (0 .. $#$list - 1)
+    {
+        next unless $map->[$i];
+        for my $cp ($list->[$i] .. $list->[$i + 1] - 1)
+        {
+            my $to = $map->[$i] + $cp - $list->[$i];
+            $delta{$cp} = $to - $cp if $to != $cp;
+        }
+    }
+
+    return \%delta;
+}
+
+# Get the full mappings to more than one code point as a hash of code point
+# => list of code points.
+sub specials
+{
+    my ($property) = @_;
+    my ($list, $map) = prop_invmap($property);
+
+    my %special;
+    for my $i (0 .. $#$list - 1)
+    {
+        $special{$list->[$i]} = $map->[$i] if ref $map->[$i];
+    }
+
+    return \%special;
+}
+
+# Get the UTF-8 byte count of a list of code points.
+sub utf8Length
+{
+    my $length = 0;
+    for (@_) { $length += $_ < 0x80 ? 1 : $_ < 0x800 ? 2 : $_ < 0x10000 ? 3 : 4; }
+
+    return $length;
+}
+
+my $upper = deltas('Simple_Uppercase_Mapping');
+my $lower = deltas('Simple_Lowercase_Mapping');
+my $fold = deltas('Simple_Case_Folding');
+my $upperSpecial = specials('Uppercase_Mapping');
+my $lowerSpecial = specials('Lowercase_Mapping');
+my $foldSpecial = specials('Case_Folding');
+
+my %cased = map { $_ => 1 } (keys %$upper, keys %$lower, keys %$fold,
+    keys %$upperSpecial, keys %$lowerSpecial, keys %$foldSpecial);
+
+# Find the most bytes any character can expand to, relative to its own size.
+my $expansion = 1;
+my $specialMax = 0;
+for my $cp (keys %cased)
+{
+    for my $mapping ([$upper, $upperSpecial], [$lower, $lowerSpecial], [$fold, $foldSpecial])
+    {
+        my ($delta, $special) = @$mapping;
+        my @to = $special->{$cp} ? @{$special->{$cp}} : ($cp + ($delta->{$cp} // 0));
+        my $length = utf8Length(@to);
+        my $ratio = int(($length + utf8Length($cp) - 1) / utf8Length($cp));
+        $expansion = $ratio if $ratio > $expansion;
+        $specialMax = $length if $special->{$cp} && $length > $specialMax;
+    }
+}
+
+my $limit = 0;
+for (keys %cased) { $limit = $_ + 1 if $_ >= $limit; }
+my $blocks = ($limit + $BLOCK_SIZE - 1) >> $BLOCK_BITS;
+
+# Give each distinct delta triple an entry, with entry 0 for no change.
+my @entries = ('0, 0, 0, 0');
+my %entryIds = ('0, 0, 0, 0' => 0);
+my @blockData;
+my %blockIds;
+my @index;
+
+for my $block (0 .. $blocks - 1)
+{
+    my @ids;
+    for my $cp ($block * $BLOCK_SIZE .. ($block + 1) * $BLOCK_SIZE - 1)
+    {
+        my $flags = ($upperSpecial->{$cp} ? 1 : 0) | ($lowerSpecial->{$cp} ? 2 : 0) | ($foldSpecial->{$cp} ? 4 : 0);
+        my $entry = join(', ', $upper->{$cp} // 0, $lower->{$cp} // 0, $fold->{$cp} // 0, $flags);
+        if (!exists $entryIds{$entry})
+        {
+            $entryIds{$entry} = scalar @entries;
+            push @entries, $entry;
+        }
+        push @ids, $entryIds{$entry};
+    }
+
+    my $key = join(',', @ids);
+    if (!exists $blockIds{$key})
+    {
+        $blockIds{$key} = scalar @blockData;
+        push @blockData, \@ids;
+    }
+    push @index, $blockIds{$key};
+}
+
+die "Too many entries\n" if @entries > 256;
+die "Too many blocks\n" if @blockData > 256;
+
+# Format a list of numbers as lines of the given width.
+sub rows
+{
+    my ($width, @values) = @_;
+    my @lines;
+    while (my @row = splice(@values, 0, $width))
+    {
+        push @lines, '    ' . join(', ', @row) . ',';
+    }
+
+    return join("\n", @lines);
+}
+
+# Format the full mappings as a sorted list of code point, length and bytes.
+sub specialRows
+{
+    my ($special) = @_;
+    my @lines;
+    for my $cp (sort { $a <=> $b } keys %$special)
+    {
+        my $string = join('', map { chr } @{$special->{$cp}});
+        utf8::encode($string);
+        my $bytes = join('', map { sprintf('\\x%02X', ord) } split(//, $string));
+        push @lines, sprintf('    { 0x%04X, %d, "%s" },', $cp, length($string), $bytes);
+    }
+
+    return join("\n", @lines);
+}
+
+my $version = Unicode::UCD::UnicodeVersion();
+my $upperRows = specialRows($upperSpecial);
+my $lowerRows = specialRows($lowerSpecial);
+my $foldRows = specialRows($foldSpecial);
+my $upperCount = keys %$upperSpecial;
+my $lowerCount = keys %$lowerSpecial;
+my $foldCount = keys %$foldSpecial;
+my $specialSize = $specialMax + 1;
+my $indexRows = rows(16, @index);
+my $entryRows = join("\n", map { "    { $_ }," } @entries);
+my $blockRows = join("\n", map { "    {\n" . rows(16, @$_) =~ s/^/    /mgr . "\n    }," } @blockData);
+my $indexCount = scalar @index;
+my $blockCount = scalar @blockData;
+my $entryCount = scalar @entries;
+
+print <<"END";
+/**
+ * \@file    casetables.h
+ * \@author  Phil Lockett <phillockett65\@gmail.com>
+ * \@version 1.0
+ *
+ * \@section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * \@section DESCRIPTION
+ *
+ * Unicode $version simple case mapping tables, generated by gencase.pl.
+ * Do not edit, regenerate using:
+ *    perl gencase.pl > casetables.h
+ *
+ * The mapping for a code point is found in two steps: caseIndex selects a
+ * block of $BLOCK_SIZE code points from caseBlocks, which selects an entry of
+ * caseDeltas holding the differences to the upper, lower and folded values.
+ * The entry flags also show which full mappings, to more than one code point,
+ * are held as UTF-8 in the sorted upperSpecials, lowerSpecials and
+ * foldSpecials tables.
+ */
+
+#if !defined(_CASETABLES_H__20261016_1015__INCLUDED_)
+#define _CASETABLES_H__20261016_1015__INCLUDED_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace utf8 {
+
+struct CaseDelta
+{
+    int32_t upper;
+    int32_t lower;
+    int32_t fold;
+    uint8_t special;
+};
+
+struct SpecialCase
+{
+    char32_t unicode;
+    uint8_t length;
+    char utf8[$specialSize];
+};
+
+constexpr uint8_t UPPER_SPECIAL{1};
+constexpr uint8_t LOWER_SPECIAL{2};
+constexpr uint8_t FOLD_SPECIAL{4};
+
+constexpr int caseBlockBits{$BLOCK_BITS};
+constexpr char32_t caseLimit{$limit};
+
+// No character expands to more than this many times its own UTF-8 length.
+constexpr size_t caseExpansion{$expansion};
+
+constexpr uint8_t caseIndex[$indexCount]{
+$indexRows
+};
+
+constexpr uint8_t caseBlocks[$blockCount][$BLOCK_SIZE]{
+$blockRows
+};
+
+constexpr CaseDelta caseDeltas[$entryCount]{
+$entryRows
+};
+
+constexpr SpecialCase upperSpecials[$upperCount]{
+$upperRows
+};
+
+constexpr SpecialCase lowerSpecials[$lowerCount]{
+$lowerRows
+};
+
+constexpr SpecialCase foldSpecials[$foldCount]{
+$foldRows
+};
+
+}   // end namespace
+
+#endif // !defined(_CASETABLES_H__20261016_1015__INCLUDED_)
+END
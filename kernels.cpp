@@ -0,0 +1,1858 @@
+/**
+ * @file    kernels.cpp
+ * @author  Phil Lockett <phillockett65@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Bulk UTF-8 processing kernels Implementation.
+ *
+ * Each kernel has a portable scalar version and, on x86, versions built for
+ * specific instruction sets using target attributes, so that the whole
+ * library can be compiled without -march flags and the best version selected
+ * at run time.
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define UTF8_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+#include "kernels.h"
+
+namespace utf8 {
+
+
+///////////////////////////////////////////////////////////////////////////////
+// CPU feature detection and kernel dispatch.
+
+/*
+ * The instruction set level is detected once, on first use, and the best
+ * kernel of each kind for that level is recorded in a table of function
+ * pointers, so that each call costs one indirect call. Setting the
+ * environment variable UTF8_SIMD_LEVEL to scalar, sse2, sse42, avx2 or avx512
+ * limits the level used, so that every kernel can be tested on one machine.
+ * A level above that supported by the CPU is ignored.
+ */
+
+/**
+ * @brief Determine the best instruction set level supported by this CPU.
+ * 
+ * @return SimdLevel the best supported level.
+ */
+SimdLevel detectSimdLevel(void)
+{
+#if defined(UTF8_X86_KERNELS)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("popcnt"))
+        return SimdLevel::avx512;
+
+    if (__builtin_cpu_supports("avx2"))
+        return SimdLevel::avx2;
+
+    if (__builtin_cpu_supports("sse4.2"))
+        return SimdLevel::sse42;
+
+    if (__builtin_cpu_supports("sse2"))
+        return SimdLevel::sse2;
+#endif
+
+    return SimdLevel::scalar;
+}
+
+/**
+ * @brief Determine the instruction set level to use, which is the best
+ * supported, unless limited by the UTF8_SIMD_LEVEL environment variable.
+ * 
+ * @return SimdLevel the level to use.
+ */
+SimdLevel selectSimdLevel(void)
+{
+    const SimdLevel detected{detectSimdLevel()};
+
+    const char * const requested{std::getenv("UTF8_SIMD_LEVEL")};
+    if (!requested)
+        return detected;
+
+    constexpr std::string_view names[]{ "scalar", "sse2", "sse42", "avx2", "avx512" };
+    for (size_t i{}; i < std::size(names); ++i)
+        if (names[i] == requested)
+            return std::min(detected, (SimdLevel)i);
+
+    return detected;
+}
+
+/**
+ * @brief Build the table of the best kernels for the given level. Kinds of
+ * kernel without a version for a level use the version for the level below.
+ * 
+ * @param level the instruction set level to use.
+ * @return KernelTable the kernels to use.
+ */
+KernelTable makeKernelTable(SimdLevel level)
+{
+    KernelTable table{ level, validateScalar, countScalar, decodeScalar, encodeScalar,
+        decode16Scalar, encode16Scalar, fromLatin1Scalar, toLatin1Scalar, flipAsciiScalar, findReferenceScalar,
+        findEscapeScalar };
+
+#if defined(UTF8_X86_KERNELS)
+    if (level >= SimdLevel::sse2)
+    {
+        table.count = countSse2;
+        table.decode = decodeSse2;
+        table.encode = encodeSse2;
+        table.decode16 = decode16Sse2;
+        table.encode16 = encode16Sse2;
+        table.fromLatin1 = fromLatin1Sse2;
+        table.toLatin1 = toLatin1Sse2;
+        table.flipAscii = flipAsciiSse2;
+        table.findReference = findReferenceSse2;
+        table.findEscape = findEscapeSse2;
+    }
+
+    if (level >= SimdLevel::sse42)
+        table.validate = validateSse42;
+
+    if (level >= SimdLevel::avx2)
+    {
+        table.validate = validateAvx2;
+        table.count = countAvx2;
+        table.fromLatin1 = fromLatin1Avx2;
+        table.toLatin1 = toLatin1Avx2;
+        table.flipAscii = flipAsciiAvx2;
+        table.findReference = findReferenceAvx2;
+        table.findEscape = findEscapeAvx2;
+    }
+
+    if (level >= SimdLevel::avx512)
+    {
+        table.count = countAvx512;
+        table.flipAscii = flipAsciiAvx512;
+        table.findReference = findReferenceAvx512;
+    }
+#endif
+
+    return table;
+}
+
+/**
+ * @brief Get the table of the best kernels for this CPU, built once on first
+ * use.
+ * 
+ * @return const KernelTable & the kernels to use.
+ */
+const KernelTable & kernels(void)
+{
+    static const KernelTable table{makeKernelTable(selectSimdLevel())};
+
+    return table;
+}
+
+/**
+ * @brief Get the instruction set level in use.
+ * 
+ * @return SimdLevel the level in use.
+ */
+SimdLevel simdLevel(void)
+{
+    return kernels().level;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// UTF-8 validation.
+
+/**
+ * @brief Find the first byte of the character that contains the byte before
+ * p, so that validation can be restarted on a character boundary.
+ * 
+ * @param begin of the buffer being validated.
+ * @param p position validated up to.
+ * @return const char * the restart position.
+ */
+const char * resync(const char * begin, const char * p)
+{
+    for (int i{1}; (i < 4) && (p - i >= begin); ++i)
+        if (((unsigned char)p[-i] & 0xC0) != 0x80)
+            return p - i;
+
+    return p;
+}
+
+/**
+ * @brief Validate a buffer one character at a time, skipping ASCII 8 bytes at
+ * a time.
+ * 
+ * @param begin of the buffer to validate.
+ * @param end of the buffer to validate.
+ * @return const char * the first invalid byte, or end if the buffer is valid.
+ */
+const char * validateScalar(const char * begin, const char * end)
+{
+    const unsigned char * p{(const unsigned char *)begin};
+    const unsigned char * const last{(const unsigned char *)end};
+
+    while (p < last)
+    {
+        if (last - p >= 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, p, 8);
+            if ((word & 0x8080808080808080) == 0)
+            {
+                p += 8;
+                continue;
+            }
+        }
+
+        const size_t len{sequenceLength(p, last)};
+        if (!len)
+            return (const char *)p;
+
+        p += len;
+    }
+
+    return end;
+}
+
+#if defined(UTF8_X86_KERNELS)
+
+/*
+ * The vector validators classify each byte together with the byte before it
+ * using three 16 entry lookups (the high and low nibbles of the previous
+ * byte and the high nibble of the current byte). Each table entry is a set of
+ * error flags and a byte is in error if all three lookups share a flag. This
+ * is the "lookup" algorithm described by Keiser & Lemire, "Validating UTF-8
+ * In Less Than One Instruction Per Byte".
+ */
+constexpr uint8_t TOO_SHORT{1 << 0};    // 11______ 0_______ or 11______ 11______
+constexpr uint8_t TOO_LONG{1 << 1};     // 0_______ 10______
+constexpr uint8_t OVERLONG_3{1 << 2};   // 11100000 100_____
+constexpr uint8_t TOO_LARGE{1 << 3};    // 11110100 1001____ and above
+constexpr uint8_t SURROGATE{1 << 4};    // 11101101 101_____
+constexpr uint8_t OVERLONG_2{1 << 5};   // 1100000_ 10______
+constexpr uint8_t TOO_LARGE_1000{1 << 6};   // 11110101 1000____ and above
+constexpr uint8_t OVERLONG_4{1 << 6};   // 11110000 1000____
+constexpr uint8_t TWO_CONTS{1 << 7};    // 10______ 10______
+constexpr uint8_t CARRY{TOO_SHORT | TOO_LONG | TWO_CONTS};
+
+alignas(16) constexpr uint8_t byte1High[16]{
+    // 0_______ ________ ASCII in byte 1.
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    // 10______ ________ continuation in byte 1.
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+    // 1100____ ________ two byte lead in byte 1.
+    TOO_SHORT | OVERLONG_2,
+    // 1101____ ________ two byte lead in byte 1.
+    TOO_SHORT,
+    // 1110____ ________ three byte lead in byte 1.
+    TOO_SHORT | OVERLONG_3 | SURROGATE,
+    // 1111____ ________ four+ byte lead in byte 1.
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+};
+
+alignas(16) constexpr uint8_t byte1Low[16]{
+    // ____0000 ________
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+    // ____0001 ________
+    CARRY | OVERLONG_2,
+    // ____001_ ________
+    CARRY,
+    CARRY,
+    // ____0100 ________
+    CARRY | TOO_LARGE,
+    // ____0101 ________
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    // ____011_ ________
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    // ____1___ ________
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    // ____1101 ________
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000
+};
+
+alignas(16) constexpr uint8_t byte2High[16]{
+    // ________ 0_______ ASCII in byte 2.
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    // ________ 1000____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+    // ________ 1001____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+    // ________ 101_____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE  | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE  | TOO_LARGE,
+    // ________ 11______ lead in byte 2.
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+};
+
+// Any of the last 3 bytes of a block that start a character too long to be
+// completed within the block.
+alignas(32) constexpr uint8_t incompleteLimit[32]{
+    255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+};
+
+/**
+ * @brief Validate a buffer 16 bytes at a time using SSE4.2.
+ * 
+ * @param begin of the buffer to validate.
+ * @param end of the buffer to validate.
+ * @return const char * the first invalid byte, or end if the buffer is valid.
+ */
+__attribute__((target("sse4.2")))
+const char * validateSse42(const char * begin, const char * end)
+{
+    const __m128i high1Table{_mm_load_si128((const __m128i *)byte1High)};
+    const __m128i low1Table{_mm_load_si128((const __m128i *)byte1Low)};
+    const __m128i high2Table{_mm_load_si128((const __m128i *)byte2High)};
+    const __m128i limit{_mm_loadu_si128((const __m128i *)(incompleteLimit + 16))};
+    const __m128i nibble{_mm_set1_epi8(0x0F)};
+
+    __m128i prev{_mm_setzero_si128()};
+    __m128i prevIncomplete{_mm_setzero_si128()};
+    __m128i error{_mm_setzero_si128()};
+
+    const char * p{begin};
+    for (; end - p >= 16; p += 16)
+    {
+        const __m128i input{_mm_loadu_si128((const __m128i *)p)};
+
+        if (_mm_movemask_epi8(input) == 0)
+        {
+            // All ASCII, only an incomplete character from before can fail.
+            error = _mm_or_si128(error, prevIncomplete);
+        }
+        else
+        {
+            const __m128i prev1{_mm_alignr_epi8(input, prev, 15)};
+            const __m128i prev2{_mm_alignr_epi8(input, prev, 14)};
+            const __m128i prev3{_mm_alignr_epi8(input, prev, 13)};
+
+            const __m128i high1{_mm_shuffle_epi8(high1Table, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble))};
+            const __m128i low1{_mm_shuffle_epi8(low1Table, _mm_and_si128(prev1, nibble))};
+            const __m128i high2{_mm_shuffle_epi8(high2Table, _mm_and_si128(_mm_srli_epi16(input, 4), nibble))};
+            const __m128i special{_mm_and_si128(_mm_and_si128(high1, low1), high2)};
+
+            // Third and fourth bytes must be continuations, nothing else may.
+            const __m128i third{_mm_subs_epu8(prev2, _mm_set1_epi8((char)(0xE0 - 0x80)))};
+            const __m128i fourth{_mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xF0 - 0x80)))};
+            const __m128i must23{_mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8((char)0x80))};
+
+            error = _mm_or_si128(error, _mm_xor_si128(must23, special));
+            prevIncomplete = _mm_subs_epu8(input, limit);
+        }
+
+        if (!_mm_testz_si128(error, error))
+            break;
+
+        prev = input;
+    }
+
+    // Finish, or locate the error, one character at a time.
+    return validateScalar(resync(begin, p), end);
+}
+
+/**
+ * @brief Get the 32 bytes ending N bytes before the end of input, continuing
+ * from the prev block.
+ */
+template<int N>
+__attribute__((target("avx2")))
+inline __m256i previous(__m256i input, __m256i prev)
+{
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - N);
+}
+
+/**
+ * @brief Validate a buffer 32 bytes at a time using AVX2.
+ * 
+ * @param begin of the buffer to validate.
+ * @param end of the buffer to validate.
+ * @return const char * the first invalid byte, or end if the buffer is valid.
+ */
+__attribute__((target("avx2")))
+const char * validateAvx2(const char * begin, const char * end)
+{
+    const __m256i high1Table{_mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)byte1High))};
+    const __m256i low1Table{_mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)byte1Low))};
+    const __m256i high2Table{_mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)byte2High))};
+    const __m256i limit{_mm256_load_si256((const __m256i *)incompleteLimit)};
+    const __m256i nibble{_mm256_set1_epi8(0x0F)};
+
+    __m256i prev{_mm256_setzero_si256()};
+    __m256i prevIncomplete{_mm256_setzero_si256()};
+    __m256i error{_mm256_setzero_si256()};
+
+    const char * p{begin};
+    for (; end - p >= 32; p += 32)
+    {
+        const __m256i input{_mm256_loadu_si256((const __m256i *)p)};
+
+        if (_mm256_movemask_epi8(input) == 0)
+        {
+            // All ASCII, only an incomplete character from before can fail.
+            error = _mm256_or_si256(error, prevIncomplete);
+        }
+        else
+        {
+            const __m256i prev1{previous<1>(input, prev)};
+            const __m256i prev2{previous<2>(input, prev)};
+            const __m256i prev3{previous<3>(input, prev)};
+
+            const __m256i high1{_mm256_shuffle_epi8(high1Table, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble))};
+            const __m256i low1{_mm256_shuffle_epi8(low1Table, _mm256_and_si256(prev1, nibble))};
+            const __m256i high2{_mm256_shuffle_epi8(high2Table, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble))};
+            const __m256i special{_mm256_and_si256(_mm256_and_si256(high1, low1), high2)};
+
+            // Third and fourth bytes must be continuations, nothing else may.
+            const __m256i third{_mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)))};
+            const __m256i fourth{_mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)))};
+            const __m256i must23{_mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80))};
+
+            error = _mm256_or_si256(error, _mm256_xor_si256(must23, special));
+            prevIncomplete = _mm256_subs_epu8(input, limit);
+        }
+
+        if (!_mm256_testz_si256(error, error))
+            break;
+
+        prev = input;
+    }
+
+    // Finish, or locate the error, one character at a time.
+    return validateScalar(resync(begin, p), end);
+}
+
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// UTF-8 character counting.
+
+/*
+ * Every character starts with exactly one byte that is not a continuation
+ * byte (10______), so counting characters is counting those bytes, which
+ * needs no decoding and no branching on the character length.
+ */
+
+/**
+ * @brief Count the non-continuation bytes in a buffer 8 bytes at a time.
+ * 
+ * @param begin of the buffer to count.
+ * @param end of the buffer to count.
+ * @return size_t character count.
+ */
+size_t countScalar(const char * begin, const char * end)
+{
+    size_t count{};
+    const char * p{begin};
+
+    for (; end - p >= 8; p += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, p, 8);
+
+        // Continuation bytes have the top bit set and the next bit clear.
+        const uint64_t continuation{word & ~(word << 1) & 0x8080808080808080};
+        count += 8 - std::popcount(continuation);
+    }
+
+    for (; p < end; ++p)
+        if (((unsigned char)*p & 0xC0) != 0x80)
+            ++count;
+
+    return count;
+}
+
+#if defined(UTF8_X86_KERNELS)
+
+/**
+ * @brief Count the non-continuation bytes in a buffer 16 bytes at a time
+ * using SSE2.
+ * 
+ * @param begin of the buffer to count.
+ * @param end of the buffer to count.
+ * @return size_t character count.
+ */
+__attribute__((target("sse2")))
+size_t countSse2(const char * begin, const char * end)
+{
+    const __m128i zero{_mm_setzero_si128()};
+    const __m128i continuation{_mm_set1_epi8((char)0xBF)};
+
+    size_t count{};
+    const char * p{begin};
+
+    while (end - p >= 16)
+    {
+        // Byte counters overflow after 255 blocks.
+        const size_t blocks{std::min<size_t>((end - p) / 16, 255)};
+        __m128i counters{zero};
+
+        for (size_t i{}; i < blocks; ++i, p += 16)
+        {
+            const __m128i input{_mm_loadu_si128((const __m128i *)p)};
+
+            // Skip ASCII blocks wholesale.
+            if (_mm_movemask_epi8(input) == 0)
+            {
+                count += 16;
+                continue;
+            }
+
+            // Signed compare, continuation bytes are -128 to -65.
+            counters = _mm_sub_epi8(counters, _mm_cmpgt_epi8(input, continuation));
+        }
+
+        const __m128i sums{_mm_sad_epu8(counters, zero)};
+        count += _mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+    }
+
+    return count + countScalar(p, end);
+}
+
+/**
+ * @brief Count the non-continuation bytes in a buffer 32 bytes at a time
+ * using AVX2.
+ * 
+ * @param begin of the buffer to count.
+ * @param end of the buffer to count.
+ * @return size_t character count.
+ */
+__attribute__((target("avx2")))
+size_t countAvx2(const char * begin, const char * end)
+{
+    const __m256i zero{_mm256_setzero_si256()};
+    const __m256i continuation{_mm256_set1_epi8((char)0xBF)};
+
+    size_t count{};
+    const char * p{begin};
+
+    while (end - p >= 32)
+    {
+        // Byte counters overflow after 255 blocks.
+        const size_t blocks{std::min<size_t>((end - p) / 32, 255)};
+        __m256i counters{zero};
+
+        for (size_t i{}; i < blocks; ++i, p += 32)
+        {
+            const __m256i input{_mm256_loadu_si256((const __m256i *)p)};
+
+            // Skip ASCII blocks wholesale.
+            if (_mm256_movemask_epi8(input) == 0)
+            {
+                count += 32;
+                continue;
+            }
+
+            // Signed compare, continuation bytes are -128 to -65.
+            counters = _mm256_sub_epi8(counters, _mm256_cmpgt_epi8(input, continuation));
+        }
+
+        const __m256i sums{_mm256_sad_epu8(counters, zero)};
+        const __m128i halves{_mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1))};
+        count += _mm_cvtsi128_si32(halves) + _mm_cvtsi128_si32(_mm_srli_si128(halves, 8));
+    }
+
+    return count + countScalar(p, end);
+}
+
+/**
+ * @brief Count the non-continuation bytes in a buffer 64 bytes at a time
+ * using AVX-512BW, where a compare produces a bit mask that can be counted
+ * directly.
+ * 
+ * @param begin of the buffer to count.
+ * @param end of the buffer to count.
+ * @return size_t character count.
+ */
+__attribute__((target("avx512bw,popcnt")))
+size_t countAvx512(const char * begin, const char * end)
+{
+    const __m512i continuation{_mm512_set1_epi8((char)0xBF)};
+
+    size_t count{};
+    const char * p{begin};
+    for (; end - p >= 64; p += 64)
+    {
+        // Signed compare, continuation bytes are -128 to -65.
+        const __m512i input{_mm512_loadu_si512((const void *)p)};
+        count += _mm_popcnt_u64(_mm512_cmpgt_epi8_mask(input, continuation));
+    }
+
+    return count + countScalar(p, end);
+}
+
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// UTF-8 to UTF-32 decoding.
+
+/*
+ * The decoders convert characters from in to out until in reaches end, out
+ * reaches last or an invalid character is found. Both in and out are left
+ * pointing past the last character converted, so an invalid character is at
+ * in when false is returned.
+ */
+
+/**
+ * @brief Decode UTF-8 to UTF-32 one character at a time.
+ * 
+ * @param in start of the UTF-8 input, returned past the last byte converted.
+ * @param end of the UTF-8 input.
+ * @param out start of the UTF-32 output, returned past the last value written.
+ * @param last end of the UTF-32 output.
+ * @return true if stopped at end or last, false if stopped by invalid input.
+ */
+bool decodeScalar(const char * & in, const char * end, char32_t * & out, char32_t * last)
+{
+    const unsigned char * p{(const unsigned char *)in};
+    const unsigned char * const stop{(const unsigned char *)end};
+    bool valid{true};
+
+    while ((p < stop) && (out < last))
+    {
+        if (*p < 0x80)
+        {
+            *out++ = *p++;
+            continue;
+        }
+
+        const size_t len{sequenceLength(p, stop)};
+        if (!len)
+        {
+            valid = false;
+            break;
+        }
+
+        *out++ = decodeSequence(p, len);
+        p += len;
+    }
+
+    in = (const char *)p;
+
+    return valid;
+}
+
+#if defined(UTF8_X86_KERNELS)
+
+/**
+ * @brief Decode UTF-8 to UTF-32 using SSE2 to convert runs of ASCII 16 bytes
+ * at a time and runs of 2 byte characters 8 characters at a time.
+ * 
+ * @param in start of the UTF-8 input, returned past the last byte converted.
+ * @param end of the UTF-8 input.
+ * @param out start of the UTF-32 output, returned past the last value written.
+ * @param last end of the UTF-32 output.
+ * @return true if stopped at end or last, false if stopped by invalid input.
+ */
+__attribute__((target("sse2")))
+bool decodeSse2(const char * & in, const char * end, char32_t * & out, char32_t * last)
+{
+    const __m128i zero{_mm_setzero_si128()};
+    const __m128i pairMask{_mm_set1_epi16((short)0xC0E0)};
+    const __m128i pairBits{_mm_set1_epi16((short)0x80C0)};
+    const __m128i overlongMask{_mm_set1_epi16(0x001E)};
+
+    // Whole blocks are written, so stop while there is room for 16 values.
+    while ((end - in >= 16) && (last - out >= 16))
+    {
+        const __m128i input{_mm_loadu_si128((const __m128i *)in)};
+        const int high{_mm_movemask_epi8(input)};
+
+        if ((high & 1) == 0)
+        {
+            // Widen the whole block, but only keep the leading ASCII bytes.
+            const __m128i low8{_mm_unpacklo_epi8(input, zero)};
+            const __m128i high8{_mm_unpackhi_epi8(input, zero)};
+            _mm_storeu_si128((__m128i *)out, _mm_unpacklo_epi16(low8, zero));
+            _mm_storeu_si128((__m128i *)(out + 4), _mm_unpackhi_epi16(low8, zero));
+            _mm_storeu_si128((__m128i *)(out + 8), _mm_unpacklo_epi16(high8, zero));
+            _mm_storeu_si128((__m128i *)(out + 12), _mm_unpackhi_epi16(high8, zero));
+
+            const int ascii{high ? std::countr_zero((unsigned)high) : 16};
+            in += ascii;
+            out += ascii;
+            continue;
+        }
+
+        // Check for 2 byte characters (110_____ 10______) that are not
+        // overlong, as little endian 16 bit lanes.
+        const __m128i pair{_mm_cmpeq_epi16(_mm_and_si128(input, pairMask), pairBits)};
+        const __m128i overlong{_mm_cmpeq_epi16(_mm_and_si128(input, overlongMask), zero)};
+        const int valid{_mm_movemask_epi8(_mm_andnot_si128(overlong, pair))};
+        const int pairs{std::countr_one((unsigned)valid) / 2};
+
+        if (pairs)
+        {
+            const __m128i lead{_mm_slli_epi16(_mm_and_si128(input, _mm_set1_epi16(0x001F)), 6)};
+            const __m128i trail{_mm_and_si128(_mm_srli_epi16(input, 8), _mm_set1_epi16(0x003F))};
+            const __m128i values{_mm_or_si128(lead, trail)};
+            _mm_storeu_si128((__m128i *)out, _mm_unpacklo_epi16(values, zero));
+            _mm_storeu_si128((__m128i *)(out + 4), _mm_unpackhi_epi16(values, zero));
+
+            in += 2 * pairs;
+            out += pairs;
+            continue;
+        }
+
+        // Anything else is converted one character at a time.
+        const unsigned char * p{(const unsigned char *)in};
+        const size_t len{sequenceLength(p, (const unsigned char *)end)};
+        if (!len)
+            return false;
+
+        *out++ = decodeSequence(p, len);
+        in += len;
+    }
+
+    return decodeScalar(in, end, out, last);
+}
+
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// UTF-32 to UTF-8 encoding.
+
+/*
+ * The encoders convert values from in to out until in reaches end, the next
+ * character will not fit before last or an invalid value is found. Both in
+ * and out are left pointing past the last value converted, so an invalid
+ * value is at in when false is returned.
+ */
+
+/**
+ * @brief Determine the number of bytes needed to encode the valid unicode
+ * values as UTF-8. Invalid values are not counted.
+ * 
+ * @param begin of the unicode values.
+ * @param end of the unicode values.
+ * @return size_t the UTF-8 byte count.
+ */
+size_t lengthScalar(const char32_t * begin, const char32_t * end)
+{
+    size_t length{};
+    for (const char32_t * p{begin}; p < end; ++p)
+        length += encodedLength(*p);
+
+    return length;
+}
+
+/**
+ * @brief Encode UTF-32 to UTF-8 one character at a time.
+ * 
+ * @param in start of the UTF-32 input, returned past the last value converted.
+ * @param end of the UTF-32 input.
+ * @param out start of the UTF-8 output, returned past the last byte written.
+ * @param last end of the UTF-8 output.
+ * @return true if stopped at end or last, false if stopped by invalid input.
+ */
+bool encodeScalar(const char32_t * & in, const char32_t * end, char * & out, char * last)
+{
+    for (; in < end; ++in)
+    {
+        const size_t len{encodedLength(*in)};
+        if (!len)
+            return false;
+
+        if ((size_t)(last - out) < len)
+            break;
+
+        encodeSequence(*in, len, out);
+        out += len;
+    }
+
+    return true;
+}
+
+#if defined(UTF8_X86_KERNELS)
+
+/**
+ * @brief Encode UTF-32 to UTF-8 using SSE2 to convert runs of ASCII 16
+ * values at a time, runs of 2 byte characters 8 values at a time and runs of
+ * 3 byte characters 4 values at a time.
+ * 
+ * @param in start of the UTF-32 input, returned past the last value converted.
+ * @param end of the UTF-32 input.
+ * @param out start of the UTF-8 output, returned past the last byte written.
+ * @param last end of the UTF-8 output.
+ * @return true if stopped at end or last, false if stopped by invalid input.
+ */
+__attribute__((target("sse2")))
+bool encodeSse2(const char32_t * & in, const char32_t * end, char * & out, char * last)
+{
+    const __m128i zero{_mm_setzero_si128()};
+    const __m128i notAscii{_mm_set1_epi32(~0x7F)};
+    const __m128i notPair{_mm_set1_epi32(~0x7FF)};
+    const __m128i notBmp{_mm_set1_epi32(~0xFFFF)};
+    const __m128i surrogateMask{_mm_set1_epi32(0xF800)};
+    const __m128i surrogate{_mm_set1_epi32(0xD800)};
+    const __m128i trailMask{_mm_set1_epi32(0x3F)};
+    const __m128i trailTag{_mm_set1_epi32(0x80)};
+
+    // Whole blocks are written, so stop while there is room for 16 bytes.
+    while ((end - in >= 16) && (last - out >= 16))
+    {
+        const __m128i in0{_mm_loadu_si128((const __m128i *)in)};
+        const __m128i in1{_mm_loadu_si128((const __m128i *)(in + 4))};
+        const __m128i in2{_mm_loadu_si128((const __m128i *)(in + 8))};
+        const __m128i in3{_mm_loadu_si128((const __m128i *)(in + 12))};
+
+        // Pack the whole block, but only keep the leading ASCII values.
+        const __m128i ascii{_mm_packs_epi16(
+            _mm_packs_epi32(_mm_cmpeq_epi32(_mm_and_si128(in0, notAscii), zero), _mm_cmpeq_epi32(_mm_and_si128(in1, notAscii), zero)),
+            _mm_packs_epi32(_mm_cmpeq_epi32(_mm_and_si128(in2, notAscii), zero), _mm_cmpeq_epi32(_mm_and_si128(in3, notAscii), zero)))};
+        const int asciiCount{std::countr_one((unsigned)_mm_movemask_epi8(ascii))};
+
+        if (asciiCount)
+        {
+            const __m128i bytes{_mm_packus_epi16(_mm_packs_epi32(in0, in1), _mm_packs_epi32(in2, in3))};
+            _mm_storeu_si128((__m128i *)out, bytes);
+
+            in += asciiCount;
+            out += asciiCount;
+            continue;
+        }
+
+        // Check for values needing 2 bytes (0x80 to 0x7FF).
+        const __m128i pair0{_mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(in0, notAscii), zero),
+            _mm_cmpeq_epi32(_mm_and_si128(in0, notPair), zero))};
+        const __m128i pair1{_mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(in1, notAscii), zero),
+            _mm_cmpeq_epi32(_mm_and_si128(in1, notPair), zero))};
+        const int pairs{std::countr_one((unsigned)_mm_movemask_epi8(_mm_packs_epi32(pair0, pair1))) / 2};
+
+        if (pairs)
+        {
+            // Build each character as a 16 bit lane, lead byte first. Bias by
+            // 0x8000 to pack with signed saturation.
+            const __m128i bias{_mm_set1_epi32(0x8000)};
+            const __m128i lead{_mm_or_si128(_mm_srli_epi32(in0, 6), _mm_set1_epi32(0xC0))};
+            const __m128i trail{_mm_slli_epi32(_mm_or_si128(_mm_and_si128(in0, _mm_set1_epi32(0x3F)), _mm_set1_epi32(0x80)), 8)};
+            const __m128i lead1{_mm_or_si128(_mm_srli_epi32(in1, 6), _mm_set1_epi32(0xC0))};
+            const __m128i trail1{_mm_slli_epi32(_mm_or_si128(_mm_and_si128(in1, _mm_set1_epi32(0x3F)), _mm_set1_epi32(0x80)), 8)};
+            const __m128i chars0{_mm_sub_epi32(_mm_or_si128(lead, trail), bias)};
+            const __m128i chars1{_mm_sub_epi32(_mm_or_si128(lead1, trail1), bias)};
+            const __m128i bytes{_mm_add_epi16(_mm_packs_epi32(chars0, chars1), _mm_set1_epi16((short)0x8000))};
+            _mm_storeu_si128((__m128i *)out, bytes);
+
+            in += pairs;
+            out += 2 * pairs;
+            continue;
+        }
+
+        // Check for values needing 3 bytes (0x800 to 0xFFFF, no surrogates).
+        const __m128i triple{_mm_andnot_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(_mm_and_si128(in0, notPair), zero),
+                _mm_cmpeq_epi32(_mm_and_si128(in0, surrogateMask), surrogate)),
+            _mm_cmpeq_epi32(_mm_and_si128(in0, notBmp), zero))};
+        const int triples{std::countr_one((unsigned)_mm_movemask_ps(_mm_castsi128_ps(triple)))};
+
+        if (triples)
+        {
+            // Build each character as a 32 bit lane, lead byte first, then
+            // store the lanes 3 bytes apart, each overwriting the unused
+            // fourth byte of the one before.
+            const __m128i lead{_mm_or_si128(_mm_srli_epi32(in0, 12), _mm_set1_epi32(0xE0))};
+            const __m128i middle{_mm_slli_epi32(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(in0, 6), trailMask), trailTag), 8)};
+            const __m128i low{_mm_slli_epi32(_mm_or_si128(_mm_and_si128(in0, trailMask), trailTag), 16)};
+            const __m128i chars{_mm_or_si128(_mm_or_si128(lead, middle), low)};
+
+            const uint32_t char0{(uint32_t)_mm_cvtsi128_si32(chars)};
+            const uint32_t char1{(uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(chars, 4))};
+            const uint32_t char2{(uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(chars, 8))};
+            const uint32_t char3{(uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(chars, 12))};
+            std::memcpy(out, &char0, 4);
+            std::memcpy(out + 3, &char1, 4);
+            std::memcpy(out + 6, &char2, 4);
+            std::memcpy(out + 9, &char3, 4);
+
+            in += triples;
+            out += 3 * triples;
+            continue;
+        }
+
+        // Anything else is converted one character at a time.
+        const size_t len{encodedLength(*in)};
+        if (!len)
+            return false;
+
+        encodeSequence(*in, len, out);
+        ++in;
+        out += len;
+    }
+
+    return encodeScalar(in, end, out, last);
+}
+
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// UTF-8 to UTF-16 decoding.
+
+/*
+ * As the UTF-32 decoders, but characters above U+FFFF are written as a
+ * surrogate pair, which is never split across the end of the output.
+ */
+
+/**
+ * @brief Write a unicode value as UTF-16.
+ * 
+ * @param unicode the valid value to write.
+ * @param out buffer to receive 1 or 2 code units.
+ * @return size_t the number of code units written.
+ */
+inline size_t writeUtf16(char32_t unicode, char16_t * out)
+{
+    if (unicode < 0x10000)
+    {
+        out[0] = (char16_t)unicode;
+
+        return 1;
+    }
+
+    unicode -= 0x10000;
+    out[0] = (char16_t)(0xD800 + (unicode >> 10));
+    out[1] = (char16_t)(0xDC00 + (unicode & 0x3FF));
+
+    return 2;
+}
+
+/**
+ * @brief Decode UTF-8 to UTF-16 one character at a time.
+ * 
+ * @param in start of the UTF-8 input, returned past the last byte converted.
+ * @param end of the UTF-8 input.
+ * @param out start of the UTF-16 output, returned past the last unit written.
+ * @param last end of the UTF-16 output.
+ * @return true if stopped at end or last, false if stopped by invalid input.
+ */
+bool decode16Scalar(const char * & in, const char * end, char16_t * & out, char16_t * last)
+{
+    const unsigned char * p{(const unsigned char *)in};
+    const unsigned char * const stop{(const unsigned char *)end};
+    bool valid{true};
+
+    while ((p < stop) && (out < last))
+    {
+        if (*p < 0x80)
+        {
+            *out++ = *p++;
+            continue;
+        }
+
+        const size_t len{sequenceLength(p, stop)};
+        if (!len)
+        {
+            valid = false;
+            break;
+        }
+
+        // A 4 byte character needs a surrogate pair.
+        if ((len == 4) && (last - out < 2))
+            break;
+
+        out += writeUtf16(decodeSequence(p, len), out);
+        p += len;
+    }
+
+    in = (const char *)p;
+
+    return valid;
+}
+
+#if defined(UTF8_X86_KERNELS)
+
+/**
+ * @brief Decode UTF-8 to UTF-16 using SSE2 to convert runs of ASCII 16 bytes
+ * at a time and runs of 2 byte characters 8 characters at a time.
+ * 
+ * @param in start of the UTF-8 input, returned past the last byte converted.
+ * @param end of the UTF-8 input.
+ * @param out start of the UTF-16 output, returned past the last unit written.
+ * @param last end of the UTF-16 output.
+ * @return true if stopped at end or last, false if stopped by invalid input.
+ */
+__attribute__((target("sse2")))
+bool decode16Sse2(const char * & in, const char * end, char16_t * & out, char16_t * last)
+{
+    const __m128i zero{_mm_setzero_si128()};
+    const __m128i pairMask{_mm_set1_epi16((short)0xC0E0)};
+    const __m128i pairBits{_mm_set1_epi16((short)0x80C0)};
+    const __m128i overlongMask{_mm_set1_epi16(0x001E)};
+
+    // Whole blocks are written, so stop while there is room for 16 units.
+    while ((end - in >= 16) && (last - out >= 16))
+    {
+        const __m128i input{_mm_loadu_si128((const __m128i *)in)};
+        const int high{_mm_movemask_epi8(input)};
+
+        if ((high & 1) == 0)
+        {
+            // Widen the whole block, but only keep the leading ASCII bytes.
+            _mm_storeu_si128((__m128i *)out, _mm_unpacklo_epi8(input, zero));
+            _mm_storeu_si128((__m128i *)(out + 8), _mm_unpackhi_epi8(input, zero));
+
+            const int ascii{high ? std::countr_zero((unsigned)high) : 16};
+            in += ascii;
+            out += ascii;
+            continue;
+        }
+
+        // Check for 2 byte characters that are not overlong, as in the UTF-32
+        // decoder, each of which is a single code unit.
+        const __m128i pair{_mm_cmpeq_epi16(_mm_and_si128(input, pairMask), pairBits)};
+        const __m128i overlong{_mm_cmpeq_epi16(_mm_and_si128(input, overlongMask), zero)};
+        const int valid{_mm_movemask_epi8(_mm_andnot_si128(overlong, pair))};
+        const int pairs{std::countr_one((unsigned)valid) / 2};
+
+        if (pairs)
+        {
+            const __m128i lead{_mm_slli_epi16(_mm_and_si128(input, _mm_set1_epi16(0x001F)), 6)};
+            const __m128i trail{_mm_and_si128(_mm_srli_epi16(input, 8), _mm_set1_epi16(0x003F))};
+            _mm_storeu_si128((__m128i *)out, _mm_or_si128(lead, trail));
+
+            in += 2 * pairs;
+            out += pairs;
+            continue;
+        }
+
+        // Anything else is converted one character at a time.
+        const unsigned char * p{(const unsigned char *)in};
+        const size_t len{sequenceLength(p, (const unsigned char *)end)};
+        if (!len)
+            return false;
+
+        out += writeUtf16(decodeSequence(p, len), out);
+        in += len;
+    }
+
+    return decode16Scalar(in, end, out, last);
+}
+
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// UTF-16 to UTF-8 encoding.
+
+/*
+ * As the UTF-32 encoders, but a surrogate pair is read as one value. An
+ * unpaired surrogate, including a high surrogate at the end of the input, is
+ * invalid.
+ */
+
+/**
+ * @brief Read a unicode value from UTF-16.
+ * 
+ * @param in start of the UTF-16 input.
+ * @param end of the UTF-16 input.
+ * @param unicode returned value.
+ * @return size_t the number of code units read, or 0 if in is an unpaired
+ *         surrogate.
+ */
+inline size_t readUtf16(const char16_t * in, const char16_t * end, char32_t & unicode)
+{
+    unicode = in[0];
+    if ((unicode & 0xF800) != 0xD800)
+        return 1;
+
+    if ((unicode >= 0xDC00) || (end - in < 2) || ((in[1] & 0xFC00) != 0xDC00))
+        return 0;
+
+    unicode = 0x10000 + ((unicode - 0xD800) << 10) + (in[1] - 0xDC00);
+
+    return 2;
+}
+
+/**
+ * @brief Determine the number of bytes needed to encode UTF-16 as UTF-8.
+ * Unpaired surrogates are not counted.
+ * 
+ * @param begin of the UTF-16 input.
+ * @param end of the UTF-16 input.
+ * @return size_t the UTF-8 byte count.
+ */
+size_t length16Scalar(const char16_t * begin, const char16_t * end)
+{
+    size_t length{};
+    for (const char16_t * p{begin}; p < end; )
+    {
+        char32_t unicode{};
+        const size_t units{readUtf16(p, end, unicode)};
+        length += units ? encodedLength(unicode) : 0;
+        p += units ? units : 1;
+    }
+
+    return length;
+}
+
+/**
+ * @brief Encode UTF-16 to UTF-8 one character at a time.
+ * 
+ * @param in start of the UTF-16 input, returned past the last unit converted.
+ * @param end of the UTF-16 input.
+ * @param out start of the UTF-8 output, returned past the last byte written.
+ * @param last end of the UTF-8 output.
+ * @return true if stopped at end or last, false if stopped by invalid input.
+ */
+bool encode16Scalar(const char16_t * & in, const char16_t * end, char * & out, char * last)
+{
+    while (in < end)
+    {
+        char32_t unicode{};
+        const size_t units{readUtf16(in, end, unicode)};
+        if (!units)
+            return false;
+
+        const size_t len{encodedLength(unicode)};
+        if ((size_t)(last - out) < len)
+            break;
+
+        encodeSequence(unicode, len, out);
+        out += len;
+        in += units;
+    }
+
+    return true;
+}
+
+#if defined(UTF8_X86_KERNELS)
+
+/**
+ * @brief Encode UTF-16 to UTF-8 using SSE2 to convert runs of ASCII 16 units
+ * at a time and runs of 2 byte characters 8 units at a time.
+ * 
+ * @param in start of the UTF-16 input, returned past the last unit converted.
+ * @param end of the UTF-16 input.
+ * @param out start of the UTF-8 output, returned past the last byte written.
+ * @param last end of the UTF-8 output.
+ * @return true if stopped at end or last, false if stopped by invalid input.
+ */
+__attribute__((target("sse2")))
+bool encode16Sse2(const char16_t * & in, const char16_t * end, char * & out, char * last)
+{
+    const __m128i zero{_mm_setzero_si128()};
+    const __m128i notAscii{_mm_set1_epi16((short)~0x7F)};
+    const __m128i notPair{_mm_set1_epi16((short)~0x7FF)};
+
+    // Whole blocks are written, so stop while there is room for 16 bytes.
+    while ((end - in >= 16) && (last - out >= 16))
+    {
+        const __m128i in0{_mm_loadu_si128((const __m128i *)in)};
+        const __m128i in1{_mm_loadu_si128((const __m128i *)(in + 8))};
+
+        // Pack the whole block, but only keep the leading ASCII units.
+        const __m128i ascii0{_mm_cmpeq_epi16(_mm_and_si128(in0, notAscii), zero)};
+        const __m128i ascii1{_mm_cmpeq_epi16(_mm_and_si128(in1, notAscii), zero)};
+        const int asciiCount{std::countr_one((unsigned)_mm_movemask_epi8(_mm_packs_epi16(ascii0, ascii1)))};
+
+        if (asciiCount)
+        {
+            _mm_storeu_si128((__m128i *)out, _mm_packus_epi16(in0, in1));
+
+            in += asciiCount;
+            out += asciiCount;
+            continue;
+        }
+
+        // Check for units needing 2 bytes (0x80 to 0x7FF).
+        const __m128i pair{_mm_andnot_si128(ascii0, _mm_cmpeq_epi16(_mm_and_si128(in0, notPair), zero))};
+        const int pairs{std::countr_one((unsigned)_mm_movemask_epi8(pair)) / 2};
+
+        if (pairs)
+        {
+            // Build each character as a 16 bit lane, lead byte first.
+            const __m128i lead{_mm_or_si128(_mm_srli_epi16(in0, 6), _mm_set1_epi16(0xC0))};
+            const __m128i trail{_mm_slli_epi16(_mm_or_si128(_mm_and_si128(in0, _mm_set1_epi16(0x3F)), _mm_set1_epi16(0x80)), 8)};
+            _mm_storeu_si128((__m128i *)out, _mm_or_si128(lead, trail));
+
+            in += pairs;
+            out += 2 * pairs;
+            continue;
+        }
+
+        // Anything else is converted one character at a time.
+        char32_t unicode{};
+        const size_t units{readUtf16(in, end, unicode)};
+        if (!units)
+            return false;
+
+        const size_t len{encodedLength(unicode)};
+        encodeSequence(unicode, len, out);
+        in += units;
+        out += len;
+    }
+
+    return encode16Scalar(in, end, out, last);
+}
+
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ISO/IEC 8859-1 to and from UTF-8.
+
+/*
+ * Every ISO/IEC 8859-1 byte is the unicode value of its character, so bytes
+ * below 0x80 are copied and the rest become 2 byte characters. In the other
+ * direction only characters up to U+00FF can be converted. As the other
+ * converters, in and out are left past the last character converted and
+ * characters are never split across the end of the output.
+ */
+
+/**
+ * @brief Convert ISO/IEC 8859-1 to UTF-8 one byte at a time.
+ * 
+ * @param in start of the ISO/IEC 8859-1 input, returned past the last byte
+ *        converted.
+ * @param end of the ISO/IEC 8859-1 input.
+ * @param out start of the UTF-8 output, returned past the last byte written.
+ * @param last end of the UTF-8 output.
+ */
+void fromLatin1Scalar(const char * & in, const char * end, char * & out, char * last)
+{
+    for (; in < end; ++in)
+    {
+        const unsigned char byte{(unsigned char)*in};
+        if (byte < 0x80)
+        {
+            if (out == last)
+                break;
+
+            *out++ = byte;
+            continue;
+        }
+
+        if (last - out < 2)
+            break;
+
+        *out++ = (char)(0xC0 | (byte >> 6));
+        *out++ = (char)(0x80 | (byte & 0x3F));
+    }
+}
+
+/**
+ * @brief Convert UTF-8 to ISO/IEC 8859-1 one character at a time.
+ * 
+ * @param in start of the UTF-8 input, returned past the last byte converted.
+ * @param end of the UTF-8 input.
+ * @param out start of the ISO/IEC 8859-1 output, returned past the last byte
+ *        written.
+ * @param last end of the ISO/IEC 8859-1 output.
+ * @return true if stopped at end or last, false if stopped by a character
+ *         that is invalid or above U+00FF.
+ */
+bool toLatin1Scalar(const char * & in, const char * end, char * & out, char * last)
+{
+    const unsigned char * p{(const unsigned char *)in};
+    const unsigned char * const stop{(const unsigned char *)end};
+    bool valid{true};
+
+    for (; (p < stop) && (out < last); ++out)
+    {
+        if (*p < 0x80)
+        {
+            *out = *p++;
+            continue;
+        }
+
+        // Only 0xC2 and 0xC3 lead characters below U+0100.
+        if (((*p & 0xFE) != 0xC2) || (stop - p < 2) || ((p[1] & 0xC0) != 0x80))
+        {
+            valid = false;
+            break;
+        }
+
+        *out = (char)(((*p & 0x03) << 6) | (p[1] & 0x3F));
+        p += 2;
+    }
+
+    in = (const char *)p;
+
+    return valid;
+}
+
+#if defined(UTF8_X86_KERNELS)
+
+/**
+ * @brief Convert ISO/IEC 8859-1 to UTF-8 using SSE2 to copy runs of ASCII 16
+ * bytes at a time.
+ * 
+ * @param in start of the ISO/IEC 8859-1 input, returned past the last byte
+ *        converted.
+ * @param end of the ISO/IEC 8859-1 input.
+ * @param out start of the UTF-8 output, returned past the last byte written.
+ * @param last end of the UTF-8 output.
+ */
+__attribute__((target("sse2")))
+void fromLatin1Sse2(const char * & in, const char * end, char * & out, char * last)
+{
+    while ((end - in >= 16) && (last - out >= 16))
+    {
+        // Copy the whole block, but only keep the leading ASCII bytes.
+        const __m128i input{_mm_loadu_si128((const __m128i *)in)};
+        _mm_storeu_si128((__m128i *)out, input);
+
+        const unsigned high{(unsigned)_mm_movemask_epi8(input)};
+        const int ascii{high ? std::countr_zero(high) : 16};
+        in += ascii;
+        out += ascii;
+
+        if ((ascii < 16) && (last - out >= 2))
+        {
+            const unsigned char byte{(unsigned char)*in++};
+            *out++ = (char)(0xC0 | (byte >> 6));
+            *out++ = (char)(0x80 | (byte & 0x3F));
+        }
+    }
+
+    fromLatin1Scalar(in, end, out, last);
+}
+
+/**
+ * @brief Convert ISO/IEC 8859-1 to UTF-8 using AVX2 to copy runs of ASCII 32
+ * bytes at a time.
+ * 
+ * @param in start of the ISO/IEC 8859-1 input, returned past the last byte
+ *        converted.
+ * @param end of the ISO/IEC 8859-1 input.
+ * @param out start of the UTF-8 output, returned past the last byte written.
+ * @param last end of the UTF-8 output.
+ */
+__attribute__((target("avx2")))
+void fromLatin1Avx2(const char * & in, const char * end, char * & out, char * last)
+{
+    while ((end - in >= 32) && (last - out >= 32))
+    {
+        // Copy the whole block, but only keep the leading ASCII bytes.
+        const __m256i input{_mm256_loadu_si256((const __m256i *)in)};
+        _mm256_storeu_si256((__m256i *)out, input);
+
+        const unsigned high{(unsigned)_mm256_movemask_epi8(input)};
+        const int ascii{high ? std::countr_zero(high) : 32};
+        in += ascii;
+        out += ascii;
+
+        if ((ascii < 32) && (last - out >= 2))
+        {
+            const unsigned char byte{(unsigned char)*in++};
+            *out++ = (char)(0xC0 | (byte >> 6));
+            *out++ = (char)(0x80 | (byte & 0x3F));
+        }
+    }
+
+    fromLatin1Scalar(in, end, out, last);
+}
+
+/**
+ * @brief Convert UTF-8 to ISO/IEC 8859-1 using SSE2 to copy runs of ASCII 16
+ * bytes at a time.
+ * 
+ * @param in start of the UTF-8 input, returned past the last byte converted.
+ * @param end of the UTF-8 input.
+ * @param out start of the ISO/IEC 8859-1 output, returned past the last byte
+ *        written.
+ * @param last end of the ISO/IEC 8859-1 output.
+ * @return true if stopped at end or last, false if stopped by a character
+ *         that is invalid or above U+00FF.
+ */
+__attribute__((target("sse2")))
+bool toLatin1Sse2(const char * & in, const char * end, char * & out, char * last)
+{
+    while ((end - in >= 16) && (last - out >= 16))
+    {
+        const __m128i input{_mm_loadu_si128((const __m128i *)in)};
+        _mm_storeu_si128((__m128i *)out, input);
+
+        const unsigned high{(unsigned)_mm_movemask_epi8(input)};
+        const int ascii{high ? std::countr_zero(high) : 16};
+        in += ascii;
+        out += ascii;
+
+        if ((ascii < 16) && (end - in >= 2))
+        {
+            const unsigned char * p{(const unsigned char *)in};
+            if (((p[0] & 0xFE) != 0xC2) || ((p[1] & 0xC0) != 0x80))
+                return false;
+
+            *out++ = (char)(((p[0] & 0x03) << 6) | (p[1] & 0x3F));
+            in += 2;
+        }
+    }
+
+    return toLatin1Scalar(in, end, out, last);
+}
+
+/**
+ * @brief Convert UTF-8 to ISO/IEC 8859-1 using AVX2 to copy runs of ASCII 32
+ * bytes at a time.
+ * 
+ * @param in start of the UTF-8 input, returned past the last byte converted.
+ * @param end of the UTF-8 input.
+ * @param out start of the ISO/IEC 8859-1 output, returned past the last byte
+ *        written.
+ * @param last end of the ISO/IEC 8859-1 output.
+ * @return true if stopped at end or last, false if stopped by a character
+ *         that is invalid or above U+00FF.
+ */
+__attribute__((target("avx2")))
+bool toLatin1Avx2(const char * & in, const char * end, char * & out, char * last)
+{
+    while ((end - in >= 32) && (last - out >= 32))
+    {
+        const __m256i input{_mm256_loadu_si256((const __m256i *)in)};
+        _mm256_storeu_si256((__m256i *)out, input);
+
+        const unsigned high{(unsigned)_mm256_movemask_epi8(input)};
+        const int ascii{high ? std::countr_zero(high) : 32};
+        in += ascii;
+        out += ascii;
+
+        if ((ascii < 32) && (end - in >= 2))
+        {
+            const unsigned char * p{(const unsigned char *)in};
+            if (((p[0] & 0xFE) != 0xC2) || ((p[1] & 0xC0) != 0x80))
+                return false;
+
+            *out++ = (char)(((p[0] & 0x03) << 6) | (p[1] & 0x3F));
+            in += 2;
+        }
+    }
+
+    return toLatin1Scalar(in, end, out, last);
+}
+
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ASCII case conversion.
+
+/*
+ * The case flipping kernels toggle the case of the 26 ASCII letters starting
+ * at first ('a' to convert to uppercase, 'A' to convert to lowercase) until
+ * end or the first non-ASCII byte, which is returned.
+ */
+
+/**
+ * @brief Flip the case of ASCII letters one byte at a time.
+ * 
+ * @param begin of the buffer to convert.
+ * @param end of the buffer to convert.
+ * @param first letter of the case to convert from.
+ * @return char * the first non-ASCII byte, or end.
+ */
+char * flipAsciiScalar(char * begin, char * end, char first)
+{
+    char * p{begin};
+    for (; (p < end) && ((*p & 0x80) == 0); ++p)
+        if ((unsigned char)(*p - first) < 26)
+            *p ^= 0x20;
+
+    return p;
+}
+
+#if defined(UTF8_X86_KERNELS)
+
+/**
+ * @brief Flip the case of ASCII letters 16 bytes at a time using SSE2.
+ * 
+ * @param begin of the buffer to convert.
+ * @param end of the buffer to convert.
+ * @param first letter of the case to convert from.
+ * @return char * the first non-ASCII byte, or end.
+ */
+__attribute__((target("sse2")))
+char * flipAsciiSse2(char * begin, char * end, char first)
+{
+    const __m128i low{_mm_set1_epi8(first - 1)};
+    const __m128i high{_mm_set1_epi8(first + 26)};
+    const __m128i flip{_mm_set1_epi8(0x20)};
+
+    char * p{begin};
+    for (; end - p >= 16; p += 16)
+    {
+        const __m128i input{_mm_loadu_si128((const __m128i *)p)};
+        if (_mm_movemask_epi8(input))
+            break;
+
+        const __m128i letters{_mm_and_si128(_mm_cmpgt_epi8(input, low), _mm_cmplt_epi8(input, high))};
+        _mm_storeu_si128((__m128i *)p, _mm_xor_si128(input, _mm_and_si128(letters, flip)));
+    }
+
+    return flipAsciiScalar(p, end, first);
+}
+
+/**
+ * @brief Flip the case of ASCII letters 32 bytes at a time using AVX2.
+ * 
+ * @param begin of the buffer to convert.
+ * @param end of the buffer to convert.
+ * @param first letter of the case to convert from.
+ * @return char * the first non-ASCII byte, or end.
+ */
+__attribute__((target("avx2")))
+char * flipAsciiAvx2(char * begin, char * end, char first)
+{
+    const __m256i low{_mm256_set1_epi8(first - 1)};
+    const __m256i high{_mm256_set1_epi8(first + 26)};
+    const __m256i flip{_mm256_set1_epi8(0x20)};
+
+    char * p{begin};
+    for (; end - p >= 32; p += 32)
+    {
+        const __m256i input{_mm256_loadu_si256((const __m256i *)p)};
+        if (_mm256_movemask_epi8(input))
+            break;
+
+        const __m256i letters{_mm256_and_si256(_mm256_cmpgt_epi8(input, low), _mm256_cmpgt_epi8(high, input))};
+        _mm256_storeu_si256((__m256i *)p, _mm256_xor_si256(input, _mm256_and_si256(letters, flip)));
+    }
+
+    return flipAsciiScalar(p, end, first);
+}
+
+/**
+ * @brief Flip the case of ASCII letters 64 bytes at a time using AVX-512BW.
+ * 
+ * @param begin of the buffer to convert.
+ * @param end of the buffer to convert.
+ * @param first letter of the case to convert from.
+ * @return char * the first non-ASCII byte, or end.
+ */
+__attribute__((target("avx512bw")))
+char * flipAsciiAvx512(char * begin, char * end, char first)
+{
+    const __m512i low{_mm512_set1_epi8(first - 1)};
+    const __m512i high{_mm512_set1_epi8(first + 26)};
+    const __m512i flip{_mm512_set1_epi8(0x20)};
+
+    char * p{begin};
+    for (; end - p >= 64; p += 64)
+    {
+        const __m512i input{_mm512_loadu_si512((const void *)p)};
+        if (_mm512_movepi8_mask(input))
+            break;
+
+        const __mmask64 letters{_mm512_cmpgt_epi8_mask(input, low) & _mm512_cmpgt_epi8_mask(high, input)};
+        _mm512_storeu_si512((void *)p, _mm512_mask_blend_epi8(letters, input, _mm512_xor_si512(input, flip)));
+    }
+
+    return flipAsciiScalar(p, end, first);
+}
+
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Character reference scanning.
+
+/*
+ * A byte needs a character reference if it is a control character or is not
+ * ASCII, which is every byte that is less than 32 when compared as a signed
+ * 8 bit value, as the vector kernels do. Runs of other bytes can be copied
+ * unchanged.
+ */
+
+/**
+ * @brief Determine if a single byte needs a character reference, whether or
+ * not char is signed.
+ * 
+ * @param c the byte to check.
+ * @return true if c is a control character or is not ASCII.
+ */
+inline bool isReferenceByte(char c)
+{
+    const unsigned char byte{(unsigned char)c};
+
+    return (byte < 32) || (byte >= 0x80);
+}
+
+/**
+ * @brief Find the next byte needing a character reference 8 bytes at a time.
+ * 
+ * @param begin of the buffer to scan.
+ * @param end of the buffer to scan.
+ * @return const char * the first byte needing a reference, or end.
+ */
+const char * findReferenceScalar(const char * begin, const char * end)
+{
+    constexpr uint64_t ones{0x0101010101010101};
+    constexpr uint64_t high{0x8080808080808080};
+
+    const char * p{begin};
+    for (; end - p >= 8; p += 8)
+    {
+        uint64_t word{};
+        std::memcpy(&word, p, 8);
+
+        // A borrow only crosses from a byte that is itself below 32.
+        if (((word - 32 * ones) | word) & high)
+            break;
+    }
+
+    for (; p != end; ++p)
+        if (isReferenceByte(*p))
+            break;
+
+    return p;
+}
+
+#if defined(UTF8_X86_KERNELS)
+
+/**
+ * @brief Find the next byte needing a character reference 16 bytes at a time
+ * using SSE2.
+ * 
+ * @param begin of the buffer to scan.
+ * @param end of the buffer to scan.
+ * @return const char * the first byte needing a reference, or end.
+ */
+__attribute__((target("sse2")))
+const char * findReferenceSse2(const char * begin, const char * end)
+{
+    const __m128i limit{_mm_set1_epi8(32)};
+
+    const char * p{begin};
+    for (; end - p >= 16; p += 16)
+    {
+        const __m128i input{_mm_loadu_si128((const __m128i *)p)};
+        const int mask{_mm_movemask_epi8(_mm_cmplt_epi8(input, limit))};
+        if (mask)
+            return p + std::countr_zero((unsigned)mask);
+    }
+
+    return findReferenceScalar(p, end);
+}
+
+/**
+ * @brief Find the next byte needing a character reference 32 bytes at a time
+ * using AVX2.
+ * 
+ * @param begin of the buffer to scan.
+ * @param end of the buffer to scan.
+ * @return const char * the first byte needing a reference, or end.
+ */
+__attribute__((target("avx2")))
+const char * findReferenceAvx2(const char * begin, const char * end)
+{
+    const __m256i limit{_mm256_set1_epi8(32)};
+
+    const char * p{begin};
+    for (; end - p >= 32; p += 32)
+    {
+        const __m256i input{_mm256_loadu_si256((const __m256i *)p)};
+        const unsigned mask{(unsigned)_mm256_movemask_epi8(_mm256_cmpgt_epi8(limit, input))};
+        if (mask)
+            return p + std::countr_zero(mask);
+    }
+
+    return findReferenceScalar(p, end);
+}
+
+/**
+ * @brief Find the next byte needing a character reference 64 bytes at a time
+ * using AVX-512BW.
+ * 
+ * @param begin of the buffer to scan.
+ * @param end of the buffer to scan.
+ * @return const char * the first byte needing a reference, or end.
+ */
+__attribute__((target("avx512bw")))
+const char * findReferenceAvx512(const char * begin, const char * end)
+{
+    const __m512i limit{_mm512_set1_epi8(32)};
+
+    const char * p{begin};
+    for (; end - p >= 64; p += 64)
+    {
+        const __m512i input{_mm512_loadu_si512((const void *)p)};
+        const uint64_t mask{_mm512_cmplt_epi8_mask(input, limit)};
+        if (mask)
+            return p + std::countr_zero(mask);
+    }
+
+    return findReferenceScalar(p, end);
+}
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// Escape scanning.
+
+/*
+ * A byte needs escaping if it is a control character, one of the special
+ * ASCII characters of the escaping mode or, if requested, is not ASCII. Tab,
+ * line feed and carriage return are found as control characters and left to
+ * the caller to copy.
+ */
+
+/**
+ * @brief Determine if a single byte needs escaping.
+ * 
+ * @param c the byte to check.
+ * @param specials the escapeSpecials ASCII characters to stop at.
+ * @param high true to also stop at bytes that are not ASCII.
+ * @return true if c needs escaping.
+ */
+inline bool needsEscape(char c, const char * specials, bool high)
+{
+    const unsigned char byte{(unsigned char)c};
+    if ((byte < 32) || (high && (byte >= 0x80)))
+        return true;
+
+    return std::memchr(specials, c, escapeSpecials) != nullptr;
+}
+
+/**
+ * @brief Find the next byte needing escaping 8 bytes at a time.
+ * 
+ * @param begin of the buffer to scan.
+ * @param end of the buffer to scan.
+ * @param specials the escapeSpecials ASCII characters to stop at.
+ * @param high true to also stop at bytes that are not ASCII.
+ * @return const char * the first byte needing escaping, or end.
+ */
+const char * findEscapeScalar(const char * begin, const char * end, const char * specials, bool high)
+{
+    constexpr uint64_t ones{0x0101010101010101};
+    constexpr uint64_t top{0x8080808080808080};
+
+    const char * p{begin};
+    for (; end - p >= 8; p += 8)
+    {
+        uint64_t word{};
+        std::memcpy(&word, p, 8);
+
+        // Borrows only cross from a byte that is itself a match, so the
+        // first match in the word is always found.
+        const uint64_t below{word - 32 * ones};
+        uint64_t found{high ? below | word : below & ~word};
+        for (size_t i{}; i < escapeSpecials; ++i)
+        {
+            const uint64_t diff{word ^ (unsigned char)specials[i] * ones};
+            found |= (diff - ones) & ~diff;
+        }
+
+        if (found & top)
+            break;
+    }
+
+    for (; p != end; ++p)
+        if (needsEscape(*p, specials, high))
+            break;
+
+    return p;
+}
+
+#if defined(UTF8_X86_KERNELS)
+
+/**
+ * @brief Find the next byte needing escaping 16 bytes at a time using SSE2.
+ * 
+ * @param begin of the buffer to scan.
+ * @param end of the buffer to scan.
+ * @param specials the escapeSpecials ASCII characters to stop at.
+ * @param high true to also stop at bytes that are not ASCII.
+ * @return const char * the first byte needing escaping, or end.
+ */
+__attribute__((target("sse2")))
+const char * findEscapeSse2(const char * begin, const char * end, const char * specials, bool high)
+{
+    // Signed bytes below floor are not ASCII and are ignored unless requested.
+    const __m128i limit{_mm_set1_epi8(32)};
+    const __m128i floor{_mm_set1_epi8(high ? -128 : 0)};
+    __m128i special[escapeSpecials];
+    for (size_t i{}; i < escapeSpecials; ++i)
+        special[i] = _mm_set1_epi8(specials[i]);
+
+    const char * p{begin};
+    for (; end - p >= 16; p += 16)
+    {
+        const __m128i input{_mm_loadu_si128((const __m128i *)p)};
+        __m128i found{_mm_andnot_si128(_mm_cmplt_epi8(input, floor), _mm_cmplt_epi8(input, limit))};
+        for (size_t i{}; i < escapeSpecials; ++i)
+            found = _mm_or_si128(found, _mm_cmpeq_epi8(input, special[i]));
+
+        const int mask{_mm_movemask_epi8(found)};
+        if (mask)
+            return p + std::countr_zero((unsigned)mask);
+    }
+
+    return findEscapeScalar(p, end, specials, high);
+}
+
+/**
+ * @brief Find the next byte needing escaping 32 bytes at a time using AVX2.
+ * 
+ * @param begin of the buffer to scan.
+ * @param end of the buffer to scan.
+ * @param specials the escapeSpecials ASCII characters to stop at.
+ * @param high true to also stop at bytes that are not ASCII.
+ * @return const char * the first byte needing escaping, or end.
+ */
+__attribute__((target("avx2")))
+const char * findEscapeAvx2(const char * begin, const char * end, const char * specials, bool high)
+{
+    const __m256i limit{_mm256_set1_epi8(32)};
+    const __m256i floor{_mm256_set1_epi8(high ? -128 : 0)};
+    __m256i special[escapeSpecials];
+    for (size_t i{}; i < escapeSpecials; ++i)
+        special[i] = _mm256_set1_epi8(specials[i]);
+
+    const char * p{begin};
+    for (; end - p >= 32; p += 32)
+    {
+        const __m256i input{_mm256_loadu_si256((const __m256i *)p)};
+        __m256i found{_mm256_andnot_si256(_mm256_cmpgt_epi8(floor, input), _mm256_cmpgt_epi8(limit, input))};
+        for (size_t i{}; i < escapeSpecials; ++i)
+            found = _mm256_or_si256(found, _mm256_cmpeq_epi8(input, special[i]));
+
+        const unsigned mask{(unsigned)_mm256_movemask_epi8(found)};
+        if (mask)
+            return p + std::countr_zero(mask);
+    }
+
+    return findEscapeScalar(p, end, specials, high);
+}
+
+#endif
+
+
+}   // end namespace
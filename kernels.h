@@ -0,0 +1,304 @@
+/**
+ * @file    kernels.h
+ * @author  Phil Lockett <phillockett65@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Internal bulk UTF-8 processing kernels interface. Not part of the public
+ * interface, use the functions declared in utf_8.h instead.
+ */
+
+#if !defined(_KERNELS_H__20261016_0910__INCLUDED_)
+#define _KERNELS_H__20261016_0910__INCLUDED_
+
+#include <algorithm>
+#include <cstddef>
+
+#include "utf_8.h"
+
+namespace utf8 {
+
+/**
+ * @brief Instruction set levels that kernels may be built for, in order of
+ * preference.
+ */
+enum class SimdLevel { scalar, sse2, sse42, avx2, avx512 };
+
+// The number of ASCII characters, besides control characters, that the
+// findEscape kernels stop at.
+constexpr size_t escapeSpecials{5};
+
+
+/**
+ * @brief Determine the length of the strictly valid UTF-8 character at p.
+ * 
+ * @param p points to the first byte of the character.
+ * @param end points past the last byte available.
+ * @return size_t the UTF-8 byte count, or 0 if not a valid UTF-8 character.
+ */
+inline size_t sequenceLength(const unsigned char * p, const unsigned char * end)
+{
+    return sequenceLength((const char *)p, (const char *)end);
+}
+
+/**
+ * @brief Decode the strictly valid UTF-8 character of length len at p.
+ * 
+ * @param p points to the first byte of the character.
+ * @param len the UTF-8 byte count from sequenceLength().
+ * @return char32_t the decoded value.
+ */
+inline char32_t decodeSequence(const unsigned char * p, size_t len)
+{
+    return decodeSequence((const char *)p, len);
+}
+
+/**
+ * @brief Encode the valid unicode value as a UTF-8 character of length len,
+ * using the constexpr encode() so the bytes are built in one place.
+ * 
+ * @param unicode value to encode.
+ * @param len the UTF-8 byte count from encodedLength().
+ * @param out buffer to receive len bytes.
+ */
+inline void encodeSequence(char32_t unicode, size_t len, char * out)
+{
+    char bytes[4]{};
+    encode(unicode, bytes);
+    std::copy_n(bytes, len, out);
+}
+
+extern const char * validateScalar(const char * begin, const char * end);
+extern const char * validateSse42(const char * begin, const char * end);
+extern const char * validateAvx2(const char * begin, const char * end);
+
+extern size_t countScalar(const char * begin, const char * end);
+extern size_t countSse2(const char * begin, const char * end);
+extern size_t countAvx2(const char * begin, const char * end);
+extern size_t countAvx512(const char * begin, const char * end);
+
+extern bool decodeScalar(const char * & in, const char * end, char32_t * & out, char32_t * last);
+extern bool decodeSse2(const char * & in, const char * end, char32_t * & out, char32_t * last);
+
+extern size_t lengthScalar(const char32_t * begin, const char32_t * end);
+extern bool encodeScalar(const char32_t * & in, const char32_t * end, char * & out, char * last);
+extern bool encodeSse2(const char32_t * & in, const char32_t * end, char * & out, char * last);
+
+extern bool decode16Scalar(const char * & in, const char * end, char16_t * & out, char16_t * last);
+extern bool decode16Sse2(const char * & in, const char * end, char16_t * & out, char16_t * last);
+
+extern size_t length16Scalar(const char16_t * begin, const char16_t * end);
+extern bool encode16Scalar(const char16_t * & in, const char16_t * end, char * & out, char * last);
+extern bool encode16Sse2(const char16_t * & in, const char16_t * end, char * & out, char * last);
+
+extern void fromLatin1Scalar(const char * & in, const char * end, char * & out, char * last);
+extern void fromLatin1Sse2(const char * & in, const char * end, char * & out, char * last);
+extern void fromLatin1Avx2(const char * & in, const char * end, char * & out, char * last);
+extern bool toLatin1Scalar(const char * & in, const char * end, char * & out, char * last);
+extern bool toLatin1Sse2(const char * & in, const char * end, char * & out, char * last);
+extern bool toLatin1Avx2(const char * & in, const char * end, char * & out, char * last);
+
+extern char * flipAsciiScalar(char * begin, char * end, char first);
+extern char * flipAsciiSse2(char * begin, char * end, char first);
+extern char * flipAsciiAvx2(char * begin, char * end, char first);
+extern char * flipAsciiAvx512(char * begin, char * end, char first);
+
+extern const char * findReferenceScalar(const char * begin, const char * end);
+extern const char * findReferenceSse2(const char * begin, const char * end);
+extern const char * findReferenceAvx2(const char * begin, const char * end);
+extern const char * findReferenceAvx512(const char * begin, const char * end);
+
+extern const char * findEscapeScalar(const char * begin, const char * end, const char * specials, bool high);
+extern const char * findEscapeSse2(const char * begin, const char * end, const char * specials, bool high);
+extern const char * findEscapeAvx2(const char * begin, const char * end, const char * specials, bool high);
+
+/**
+ * @brief The best kernel of each kind for the instruction set level in use.
+ */
+struct KernelTable
+{
+    SimdLevel level;
+    const char * (*validate)(const char * begin, const char * end);
+    size_t (*count)(const char * begin, const char * end);
+    bool (*decode)(const char * & in, const char * end, char32_t * & out, char32_t * last);
+    bool (*encode)(const char32_t * & in, const char32_t * end, char * & out, char * last);
+    bool (*decode16)(const char * & in, const char * end, char16_t * & out, char16_t * last);
+    bool (*encode16)(const char16_t * & in, const char16_t * end, char * & out, char * last);
+    void (*fromLatin1)(const char * & in, const char * end, char * & out, char * last);
+    bool (*toLatin1)(const char * & in, const char * end, char * & out, char * last);
+    char * (*flipAscii)(char * begin, char * end, char first);
+    const char * (*findReference)(const char * begin, const char * end);
+    const char * (*findEscape)(const char * begin, const char * end, const char * specials, bool high);
+};
+
+extern const KernelTable & kernels(void);
+extern SimdLevel simdLevel(void);
+
+/**
+ * @brief Find the first invalid byte using the best kernel for this CPU.
+ * 
+ * @param begin of the buffer to validate.
+ * @param end of the buffer to validate.
+ * @return const char * the first invalid byte, or end if the buffer is valid.
+ */
+inline const char * validateUtf8(const char * begin, const char * end)
+{
+    return kernels().validate(begin, end);
+}
+
+/**
+ * @brief Count the characters using the best kernel for this CPU.
+ * 
+ * @param begin of the buffer to count.
+ * @param end of the buffer to count.
+ * @return size_t character count.
+ */
+inline size_t countUtf8(const char * begin, const char * end)
+{
+    return kernels().count(begin, end);
+}
+
+/**
+ * @brief Decode UTF-8 to UTF-32 using the best kernel for this CPU.
+ * 
+ * @param in start of the UTF-8 input, returned past the last byte converted.
+ * @param end of the UTF-8 input.
+ * @param out start of the UTF-32 output, returned past the last value written.
+ * @param last end of the UTF-32 output.
+ * @return true if stopped at end or last, false if stopped by invalid input.
+ */
+inline bool decodeUtf8(const char * & in, const char * end, char32_t * & out, char32_t * last)
+{
+    return kernels().decode(in, end, out, last);
+}
+
+/**
+ * @brief Encode UTF-32 to UTF-8 using the best kernel for this CPU.
+ * 
+ * @param in start of the UTF-32 input, returned past the last value converted.
+ * @param end of the UTF-32 input.
+ * @param out start of the UTF-8 output, returned past the last byte written.
+ * @param last end of the UTF-8 output.
+ * @return true if stopped at end or last, false if stopped by invalid input.
+ */
+inline bool encodeUtf8(const char32_t * & in, const char32_t * end, char * & out, char * last)
+{
+    return kernels().encode(in, end, out, last);
+}
+
+/**
+ * @brief Decode UTF-8 to UTF-16 using the best kernel for this CPU.
+ * 
+ * @param in start of the UTF-8 input, returned past the last byte converted.
+ * @param end of the UTF-8 input.
+ * @param out start of the UTF-16 output, returned past the last unit written.
+ * @param last end of the UTF-16 output.
+ * @return true if stopped at end or last, false if stopped by invalid input.
+ */
+inline bool decode16Utf8(const char * & in, const char * end, char16_t * & out, char16_t * last)
+{
+    return kernels().decode16(in, end, out, last);
+}
+
+/**
+ * @brief Encode UTF-16 to UTF-8 using the best kernel for this CPU.
+ * 
+ * @param in start of the UTF-16 input, returned past the last unit converted.
+ * @param end of the UTF-16 input.
+ * @param out start of the UTF-8 output, returned past the last byte written.
+ * @param last end of the UTF-8 output.
+ * @return true if stopped at end or last, false if stopped by invalid input.
+ */
+inline bool encode16Utf8(const char16_t * & in, const char16_t * end, char * & out, char * last)
+{
+    return kernels().encode16(in, end, out, last);
+}
+
+/**
+ * @brief Convert ISO/IEC 8859-1 to UTF-8 using the best kernel for this CPU.
+ * 
+ * @param in start of the ISO/IEC 8859-1 input, returned past the last byte
+ *        converted.
+ * @param end of the ISO/IEC 8859-1 input.
+ * @param out start of the UTF-8 output, returned past the last byte written.
+ * @param last end of the UTF-8 output.
+ */
+inline void fromLatin1(const char * & in, const char * end, char * & out, char * last)
+{
+    kernels().fromLatin1(in, end, out, last);
+}
+
+/**
+ * @brief Convert UTF-8 to ISO/IEC 8859-1 using the best kernel for this CPU.
+ * 
+ * @param in start of the UTF-8 input, returned past the last byte converted.
+ * @param end of the UTF-8 input.
+ * @param out start of the ISO/IEC 8859-1 output, returned past the last byte
+ *        written.
+ * @param last end of the ISO/IEC 8859-1 output.
+ * @return true if stopped at end or last, false if stopped by a character
+ *         that is invalid or above U+00FF.
+ */
+inline bool toLatin1(const char * & in, const char * end, char * & out, char * last)
+{
+    return kernels().toLatin1(in, end, out, last);
+}
+
+/**
+ * @brief Flip the case of ASCII letters using the best kernel for this CPU.
+ * 
+ * @param begin of the buffer to convert.
+ * @param end of the buffer to convert.
+ * @param first letter of the case to convert from.
+ * @return char * the first non-ASCII byte, or end.
+ */
+inline char * flipAscii(char * begin, char * end, char first)
+{
+    return kernels().flipAscii(begin, end, first);
+}
+
+/**
+ * @brief Find the next byte needing a character reference using the best
+ * kernel for this CPU.
+ * 
+ * @param begin of the buffer to scan.
+ * @param end of the buffer to scan.
+ * @return const char * the first byte needing a reference, or end.
+ */
+inline const char * findReference(const char * begin, const char * end)
+{
+    return kernels().findReference(begin, end);
+}
+
+/**
+ * @brief Find the next byte needing escaping using the best kernel for this
+ * CPU.
+ * 
+ * @param begin of the buffer to scan.
+ * @param end of the buffer to scan.
+ * @param specials the escapeSpecials ASCII characters to stop at.
+ * @param high true to also stop at bytes that are not ASCII.
+ * @return const char * the first byte needing escaping, or end.
+ */
+inline const char * findEscape(const char * begin, const char * end, const char * specials, bool high)
+{
+    return kernels().findEscape(begin, end, specials, high);
+}
+
+}   // end namespace
+
+#endif // !defined(_KERNELS_H__20261016_0910__INCLUDED_)
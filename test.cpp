@@ -33,6 +33,7 @@
 
 #include <iostream>
 #include <algorithm>
+#include <array>
 
 #include "unittest.h"
 #include "utf_8.h"
@@ -541,6 +542,1281 @@ NEXT_CASE(test91, "charCount - Test ASCII & UTF-8.")
     REQUIRE(utf8::charCount(asciiUtf8) == 13)
     REQUIRE(asciiUtf8.length() == 20)
 
+NEXT_CASE(test92, "charCount - Test large ASCII & UTF-8.")
+
+    std::string large{};
+    for (int i{}; i < 10000; ++i)
+        large += (i % 3) ? asciiOnly : asciiUtf8;
+
+    REQUIRE(utf8::charCount(large) == 3334 * 13 + 6666 * 12)
+
+NEXT_CASE(test93, "charCount - Test malformed byte count.")
+
+    size_t malformed{99};
+    REQUIRE(utf8::charCount(large, malformed) == 3334 * 13 + 6666 * 12)
+    REQUIRE(malformed == 0)
+
+    const char brokenData[6]{ 0x41, (char)0xE2, (char)0x82, 0x41, (char)0xC3, 0 };
+    REQUIRE(utf8::charCount(brokenData, malformed) == 5)
+    REQUIRE(malformed == 3)
+
+    // A stray continuation byte is a character, as codePoints() counts it.
+    const std::string stray{"A\x80\x80" + std::string{copyrightData}};
+    REQUIRE(utf8::charCount(stray) == 4)
+    REQUIRE(utf8::charCount(stray) == utf8::charCount<utf8::Replace>(stray))
+    REQUIRE(utf8::charCount(stray) == (size_t)std::ranges::distance(utf8::codePoints(stray)))
+    REQUIRE(utf8::truncateToChars(stray, 3).length() == 3)
+
+END_TEST
+
+
+/**
+ * @section 10 - characterRefsLength & writeCharacterRefs test.
+ */
+UNIT_TEST(test100, "characterRefsLength - Test ASCII only.")
+
+    REQUIRE(utf8::characterRefsLength(asciiOnly) == asciiOnly.length())
+
+NEXT_CASE(test101, "characterRefsLength - Test ASCII & UTF-8.")
+
+    const std::string expected{"Hello &#169; &#246; &#11105; &#127187;"};
+    REQUIRE(utf8::characterRefsLength(asciiUtf8) == expected.length())
+
+NEXT_CASE(test102, "writeCharacterRefs - Test ASCII & UTF-8.")
+
+    std::string output(expected.length(), '\0');
+    char * end{utf8::writeCharacterRefs(asciiUtf8, output.data())};
+    REQUIRE(end == output.data() + output.length())
+    REQUIRE(output.compare(expected) == 0)
+
+NEXT_CASE(test103, "useCharacterRefs - Test in place ISO/IEC 8859-1 & control characters.")
+
+    const unsigned char string1[]{ 0x41, 0x0A, 0xE9, 0x42, 0 };
+    std::string input{(char *)string1};
+    utf8::useCharacterRefs(input);
+    REQUIRE(input.compare("A&#10;&#233;B") == 0)
+
+NEXT_CASE(test104, "useCharacterRefs - Test in place ASCII only (no change).")
+
+    input = asciiOnly;
+    utf8::useCharacterRefs(input);
+    REQUIRE(input.compare(asciiOnly) == 0)
+
+NEXT_CASE(test105, "useCharacterRefs - Test large repeated UTF-8 string.")
+
+    std::string large{};
+    std::string largeExpected{};
+    for (int i{}; i < 10000; ++i)
+    {
+        large += asciiUtf8;
+        largeExpected += expected;
+    }
+    utf8::useCharacterRefs(large);
+    REQUIRE(large.compare(largeExpected) == 0)
+
+END_TEST
+
+
+/**
+ * @section 11 - validate & findInvalid whole buffer validation test.
+ */
+UNIT_TEST(test110, "validate - Test ASCII & UTF-8.")
+
+    REQUIRE(utf8::validate("") == true)
+    REQUIRE(utf8::validate(asciiOnly) == true)
+    REQUIRE(utf8::validate(asciiUtf8) == true)
+    REQUIRE(utf8::findInvalid(asciiUtf8) == std::string_view::npos)
+
+NEXT_CASE(test111, "validate - Test overlong encodings.")
+
+    const char overlong2Data[3]{ (char)0xC0, (char)0x80, 0 };
+    const char overlong3Data[4]{ (char)0xE0, (char)0x82, (char)0xAC, 0 };
+    const char overlong4Data[5]{ (char)0xF0, (char)0x82, (char)0x82, (char)0xAC, 0 };
+    REQUIRE(utf8::validate(overlong2Data) == false)
+    REQUIRE(utf8::validate(overlong3Data) == false)
+    REQUIRE(utf8::validate(overlong4Data) == false)
+
+NEXT_CASE(test112, "validate - Test surrogates.")
+
+    const char surrogateData[4]{ (char)0xED, (char)0xA0, (char)0x80, 0 };
+    const char beforeSurrogateData[4]{ (char)0xED, (char)0x9F, (char)0xBF, 0 };
+    REQUIRE(utf8::validate(surrogateData) == false)
+    REQUIRE(utf8::validate(beforeSurrogateData) == true)
+
+NEXT_CASE(test113, "validate - Test values above U+10FFFF.")
+
+    const char maxData[5]{ (char)0xF4, (char)0x8F, (char)0xBF, (char)0xBF, 0 };
+    const char tooLargeData[5]{ (char)0xF4, (char)0x90, (char)0x80, (char)0x80, 0 };
+    const char f5Data[5]{ (char)0xF5, (char)0x80, (char)0x80, (char)0x80, 0 };
+    REQUIRE(utf8::validate(maxData) == true)
+    REQUIRE(utf8::validate(tooLargeData) == false)
+    REQUIRE(utf8::validate(f5Data) == false)
+
+NEXT_CASE(test114, "validate - Test missing and unexpected continuation bytes.")
+
+    const char cent1Data[2]{ (char)0xC2, 0 };
+    const char hwair4Data[5]{ (char)0xF0, (char)0x90, (char)0x8D, (char)0x08, 0 };
+    const char continuationData[2]{ (char)0xA4, 0 };
+    REQUIRE(utf8::validate(cent1Data) == false)
+    REQUIRE(utf8::validate(hwair4Data) == false)
+    REQUIRE(utf8::validate(continuationData) == false)
+
+NEXT_CASE(test115, "findInvalid - Test error position in a large buffer.")
+
+    std::string large{};
+    for (int i{}; i < 1000; ++i)
+        large += asciiUtf8;
+
+    REQUIRE(utf8::validate(large) == true)
+
+    // Check positions either side of the vector block boundaries.
+    bool found{true};
+    for (size_t pos{5000}; pos < 5070; ++pos)
+    {
+        // Only insert on character boundaries.
+        if ((large[pos] & 0xC0) == 0x80)
+            continue;
+
+        std::string work{large};
+        work.insert(pos, 1, (char)0xFF);
+        if (utf8::findInvalid(work) != pos)
+            found = false;
+    }
+    REQUIRE(found == true)
+
+NEXT_CASE(test116, "findInvalid - Test truncated character at end of large buffer.")
+
+    std::string truncated{large + clubs3Data};
+    truncated.pop_back();
+    REQUIRE(utf8::findInvalid(truncated) == large.length())
+
+END_TEST
+
+
+/**
+ * @section 12 - decode bulk UTF-8 to UTF-32 test.
+ */
+UNIT_TEST(test120, "decode - Test ASCII & UTF-8.")
+
+    const std::u32string expected{U"Hello \u00A9 \u00F6 \u2B61 \U0001F0D3"};
+    char32_t output[32]{};
+
+    utf8::ConvertResult result{utf8::decode(asciiUtf8, output, 32)};
+    REQUIRE(result.consumed == asciiUtf8.length())
+    REQUIRE(result.produced == 13)
+    REQUIRE(result.error == std::string_view::npos)
+    REQUIRE(expected.compare(0, 13, output, 13) == 0)
+
+NEXT_CASE(test121, "decode - Test output capacity.")
+
+    result = utf8::decode(asciiUtf8, output, 7);
+    REQUIRE(result.consumed == 8)
+    REQUIRE(result.produced == 7)
+    REQUIRE(result.error == std::string_view::npos)
+
+NEXT_CASE(test122, "decode - Test invalid character position.")
+
+    const char brokenData[6]{ 0x41, (char)0xC3, (char)0xB6, (char)0xC0, (char)0x80, 0 };
+    result = utf8::decode(brokenData, output, 32);
+    REQUIRE(result.consumed == 3)
+    REQUIRE(result.produced == 2)
+    REQUIRE(result.error == 3)
+    REQUIRE(output[1] == 0xF6)
+
+NEXT_CASE(test123, "decode - Test large ASCII & 2 byte runs.")
+
+    std::string large{};
+    std::u32string largeExpected{};
+    for (int i{}; i < 1000; ++i)
+    {
+        large += (i % 2) ? "Hello World! " : "Привет мир ";
+        largeExpected += (i % 2) ? U"Hello World! " : U"Привет мир ";
+    }
+
+    std::vector<char32_t> largeOutput(large.length());
+    result = utf8::decode(large, largeOutput.data(), largeOutput.size());
+    REQUIRE(result.consumed == large.length())
+    REQUIRE(result.produced == largeExpected.length())
+    REQUIRE(std::equal(largeExpected.begin(), largeExpected.end(), largeOutput.begin()) == true)
+
+END_TEST
+
+
+/**
+ * @section 13 - encode bulk UTF-32 to UTF-8 test.
+ */
+UNIT_TEST(test130, "encodedLength - Test ASCII & UTF-8.")
+
+    const std::u32string input{U"Hello \u00A9 \u00F6 \u2B61 \U0001F0D3"};
+    REQUIRE(utf8::encodedLength(input) == asciiUtf8.length())
+
+NEXT_CASE(test131, "encode - Test ASCII & UTF-8.")
+
+    char output[32]{};
+    utf8::ConvertResult result{utf8::encode(input, output, 32)};
+    REQUIRE(result.consumed == input.length())
+    REQUIRE(result.produced == asciiUtf8.length())
+    REQUIRE(result.error == std::string_view::npos)
+    REQUIRE(asciiUtf8.compare(0, result.produced, output, result.produced) == 0)
+
+NEXT_CASE(test132, "encode - Test characters are not split by output capacity.")
+
+    result = utf8::encode(input, output, 18);
+    REQUIRE(result.consumed == 12)
+    REQUIRE(result.produced == 16)
+    REQUIRE(result.error == std::string_view::npos)
+
+NEXT_CASE(test133, "encode - Test invalid value position.")
+
+    const std::u32string broken{U"A\u00F6"};
+    std::u32string surrogate{broken};
+    surrogate.push_back(0xD800);
+    result = utf8::encode(surrogate, output, 32);
+    REQUIRE(result.consumed == 2)
+    REQUIRE(result.produced == 3)
+    REQUIRE(result.error == 2)
+
+    std::u32string tooLarge{broken};
+    tooLarge.push_back(0x110000);
+    REQUIRE(utf8::encode(tooLarge, output, 32).error == 2)
+    REQUIRE(utf8::encodedLength(tooLarge) == 3)
+
+NEXT_CASE(test134, "encode - Test large input to output iterator.")
+
+    std::u32string large{};
+    std::string expected{};
+    for (int i{}; i < 1000; ++i)
+    {
+        large += (i % 2) ? U"Hello World! " : U"Привет мир ";
+        large += input;
+        expected += (i % 2) ? "Hello World! " : "Привет мир ";
+        expected += asciiUtf8;
+    }
+
+    std::string encoded{};
+    utf8::encode(large, std::back_inserter(encoded));
+    REQUIRE(encoded.compare(expected) == 0)
+    REQUIRE(utf8::encodedLength(large) == expected.length())
+
+NEXT_CASE(test135, "encode - Test runs of 3 byte characters.")
+
+    std::u32string bmp{};
+    std::string bmpExpected{};
+    for (int i{}; i < 100; ++i)
+    {
+        bmp += U"⭡世�ࠀ퟿ ";
+        bmpExpected += "⭡世�ࠀ퟿ ";
+    }
+
+    std::string bmpOutput(bmpExpected.length(), '\0');
+    result = utf8::encode(bmp, bmpOutput.data(), bmpOutput.length());
+    REQUIRE(result.consumed == bmp.length())
+    REQUIRE(bmpOutput.compare(bmpExpected) == 0)
+
+    result = utf8::encode(bmp, bmpOutput.data(), 100);
+    REQUIRE(result.consumed == 36)
+    REQUIRE(result.produced == 98)
+
+    bmp[40] = 0xDFFF;
+    result = utf8::encode(bmp, bmpOutput.data(), bmpOutput.length());
+    REQUIRE(result.consumed == 40)
+    REQUIRE(result.error == 40)
+
+END_TEST
+
+
+/**
+ * @section 14 - constexpr encode & Character test.
+ */
+constexpr utf8::Character clubs3Character{0x1F0D3};
+constexpr size_t upArrowLength{utf8::encodedLength(0x2B61)};
+
+UNIT_TEST(test140, "encode - Test 1, 2, 3 & 4 byte characters.")
+
+    char output[4]{};
+    REQUIRE(utf8::encode(0x41, output) == 1)
+    REQUIRE(std::string_view(output, 1).compare(AData) == 0)
+    REQUIRE(utf8::encode(0xA9, output) == 2)
+    REQUIRE(std::string_view(output, 2).compare(copyrightData) == 0)
+    REQUIRE(utf8::encode(0x2B61, output) == 3)
+    REQUIRE(std::string_view(output, 3).compare(upArrowData) == 0)
+    REQUIRE(utf8::encode(0x1F0D3, output) == 4)
+    REQUIRE(std::string_view(output, 4).compare(clubs3Data) == 0)
+
+NEXT_CASE(test141, "encode - Test invalid values.")
+
+    REQUIRE(utf8::encode(0xD800, output) == 0)
+    REQUIRE(utf8::encode(0xDFFF, output) == 0)
+    REQUIRE(utf8::encode(0x110000, output) == 0)
+
+NEXT_CASE(test142, "Character - Test compile time construction.")
+
+    REQUIRE(upArrowLength == 3)
+    REQUIRE(clubs3Character.size() == 4)
+    REQUIRE(clubs3Character.view().compare(clubs3Data) == 0)
+
+NEXT_CASE(test143, "Character - Test default & invalid characters are empty.")
+
+    REQUIRE(utf8::Character{}.empty() == true)
+    REQUIRE(utf8::Character{0xD800}.empty() == true)
+    REQUIRE(utf8::Character{0xF6}.view().compare(umlautData) == 0)
+
+END_TEST
+
+
+/**
+ * @section 15 - Unicode case mapping test.
+ */
+UNIT_TEST(test150, "upperCase, lowerCase & foldCase - Test simple mappings.")
+
+    REQUIRE(utf8::upperCase(U'a') == U'A')
+    REQUIRE(utf8::upperCase(U'ß') == U'ß')
+    REQUIRE(utf8::upperCase(U'ÿ') == U'Ÿ')
+    REQUIRE(utf8::lowerCase(U'Σ') == U'σ')
+    REQUIRE(utf8::lowerCase(U'İ') == U'i')
+    REQUIRE(utf8::foldCase(U'ς') == U'σ')
+    REQUIRE(utf8::upperCase(U'\U0001E922') == U'\U0001E900')
+    REQUIRE(utf8::upperCase(0x110000) == 0x110000)
+
+NEXT_CASE(test151, "makeUpper - Test Greek, Cyrillic & Latin Extended.")
+
+    std::string result{"αβγ δέλτα, привет, łódź ǆ"};
+    utf8::makeUpper(result);
+    REQUIRE(result.compare("ΑΒΓ ΔΈΛΤΑ, ПРИВЕТ, ŁÓDŹ Ǆ") == 0)
+
+NEXT_CASE(test152, "makeLower - Test Greek, Cyrillic & Latin Extended.")
+
+    utf8::makeLower(result);
+    REQUIRE(result.compare("αβγ δέλτα, привет, łódź ǆ") == 0)
+
+NEXT_CASE(test153, "makeUpper - Test length changing mappings are unchanged.")
+
+    result = "straße ı ſ";
+    utf8::makeUpper(result);
+    REQUIRE(result.compare("STRAßE ı ſ") == 0)
+
+NEXT_CASE(test154, "makeLower - Test invalid bytes are skipped.")
+
+    const unsigned char brokenData[]{ 0x41, 0xC3, 0x42, 0x80, 0xD0, 0x96, 0 };
+    const unsigned char expectedData[]{ 0x61, 0xC3, 0x62, 0x80, 0xD0, 0xB6, 0 };
+    result = (const char *)brokenData;
+    utf8::makeLower(result);
+    REQUIRE(result.compare((const char *)expectedData) == 0)
+
+NEXT_CASE(test155, "toUpper - Test Cyrillic.")
+
+    result = "жук";
+    REQUIRE(utf8::toUpper(result) == 2)
+    REQUIRE(result.compare("Жук") == 0)
+    REQUIRE(utf8::toUpper(result) == 0)
+
+NEXT_CASE(test156, "makeUpper - Test large ASCII buffer.")
+
+    std::string large{};
+    std::string expected{};
+    for (int i{}; i < 1000; ++i)
+    {
+        large += asciiOnly;
+        expected += "HELLO WORLD!";
+    }
+    utf8::makeUpper(large);
+    REQUIRE(large.compare(expected) == 0)
+
+END_TEST
+
+
+/**
+ * @section 16 - Length changing case conversion test.
+ */
+UNIT_TEST(test160, "toUpperCopy - Test length changing mappings.")
+
+    REQUIRE(utf8::toUpperCopy("straße ǰ ﬃ ı").compare("STRASSE J̌ FFI I") == 0)
+    REQUIRE(utf8::toUpperCopy(asciiOnly).compare("HELLO WORLD!") == 0)
+
+NEXT_CASE(test161, "toLowerCopy - Test length changing mappings.")
+
+    REQUIRE(utf8::toLowerCopy("İSTANBUL Ⱥ").compare("i̇stanbul ⱥ") == 0)
+
+NEXT_CASE(test162, "caseFold - Test case insensitive comparison.")
+
+    REQUIRE(utf8::caseFold("Straße").compare(utf8::caseFold("STRASSE")) == 0)
+    REQUIRE(utf8::caseFold("ΣΊΣΥΦΟΣ").compare(utf8::caseFold("σίσυφος")) == 0)
+
+NEXT_CASE(test163, "toUpperCopy - Test worst case bound.")
+
+    const std::string expanding{"ΐΐΐ"};
+    std::string output(utf8::caseCopyBound(expanding.length()), '\0');
+    char * end{utf8::toUpperCopy(expanding, output.data())};
+    REQUIRE(end == output.data() + output.length())
+    REQUIRE(output.compare("\u0399\u0308\u0301\u0399\u0308\u0301\u0399\u0308\u0301") == 0)
+
+NEXT_CASE(test164, "toLowerCopy - Test invalid bytes are copied.")
+
+    const unsigned char brokenData[]{ 0x41, 0xC3, 0x42, 0x80, 0xD0, 0x96, 0 };
+    const unsigned char expectedData[]{ 0x61, 0xC3, 0x62, 0x80, 0xD0, 0xB6, 0 };
+    REQUIRE(utf8::toLowerCopy((const char *)brokenData).compare((const char *)expectedData) == 0)
+
+NEXT_CASE(test165, "toUpperCopy - Test large mixed buffer.")
+
+    std::string large{};
+    std::string expected{};
+    for (int i{}; i < 1000; ++i)
+    {
+        large += "Hello Straße, привет! ";
+        expected += "HELLO STRASSE, ПРИВЕТ! ";
+    }
+    REQUIRE(utf8::toUpperCopy(large).compare(expected) == 0)
+
+END_TEST
+
+
+/**
+ * @section 17 - StreamDecoder chunked input test.
+ */
+UNIT_TEST(test170, "StreamDecoder - Test whole input as one chunk.")
+
+    const std::u32string expected{U"Hello \u00A9 \u00F6 \u2B61 \U0001F0D3"};
+    utf8::StreamDecoder decoder{};
+
+    utf8::StreamDecoder::Spans spans{decoder.feed(asciiUtf8)};
+    REQUIRE(spans.head.empty() == true)
+    REQUIRE(spans.body.compare(asciiUtf8) == 0)
+    REQUIRE(spans.body.data() == asciiUtf8.data())
+    REQUIRE(spans.error == std::string_view::npos)
+    REQUIRE(decoder.finish() == true)
+
+NEXT_CASE(test171, "StreamDecoder - Test characters split across chunks.")
+
+    spans = decoder.feed(std::string_view{asciiUtf8}.substr(0, 18));
+    REQUIRE(spans.body.compare("Hello © ö ⭡ ") == 0)
+    REQUIRE(decoder.pending() == 2)
+
+    spans = decoder.feed(std::string_view{asciiUtf8}.substr(18, 1));
+    REQUIRE(spans.head.empty() == true)
+    REQUIRE(spans.body.empty() == true)
+    REQUIRE(decoder.pending() == 3)
+
+    spans = decoder.feed(std::string_view{asciiUtf8}.substr(19));
+    REQUIRE(spans.head.compare(clubs3Data) == 0)
+    REQUIRE(spans.body.empty() == true)
+    REQUIRE(decoder.finish() == true)
+
+NEXT_CASE(test172, "StreamDecoder - Test decode one byte at a time.")
+
+    std::u32string decoded{};
+    bool valid{true};
+    for (size_t i{}; i < asciiUtf8.length(); ++i)
+        valid = valid && decoder.decode(std::string_view{asciiUtf8}.substr(i, 1), [&decoded](char32_t c) { decoded += c; });
+
+    REQUIRE(valid == true)
+    REQUIRE(decoded.compare(expected) == 0)
+    REQUIRE(decoder.finish() == true)
+
+NEXT_CASE(test173, "StreamDecoder - Test incomplete character at finish.")
+
+    spans = decoder.feed(std::string_view{clubs3Data}.substr(0, 3));
+    REQUIRE(spans.error == std::string_view::npos)
+    REQUIRE(decoder.finish() == false)
+    REQUIRE(decoder.pending() == 0)
+
+NEXT_CASE(test174, "StreamDecoder - Test invalid bytes.")
+
+    const char brokenData[5]{ 0x41, (char)0xC3, 0x42, 0x43, 0 };
+    spans = decoder.feed(brokenData);
+    REQUIRE(spans.body.compare("A") == 0)
+    REQUIRE(spans.error == 1)
+
+    spans = decoder.feed(std::string_view{upArrowData}.substr(0, 1));
+    REQUIRE(decoder.pending() == 1)
+    spans = decoder.feed("AB");
+    REQUIRE(spans.error == 0)
+    REQUIRE(decoder.pending() == 0)
+
+NEXT_CASE(test175, "StreamDecoder - Test completed character with a new split character.")
+
+    const std::string twoClubs{std::string{clubs3Data} + clubs3Data};
+    spans = decoder.feed(std::string_view{twoClubs}.substr(0, 1));
+    spans = decoder.feed(std::string_view{twoClubs}.substr(1, 5));
+    REQUIRE(spans.head.compare(clubs3Data) == 0)
+    REQUIRE(decoder.pending() == 2)
+    REQUIRE(decoder.feed(std::string_view{twoClubs}.substr(6)).head.compare(clubs3Data) == 0)
+    REQUIRE(decoder.finish() == true)
+
+END_TEST
+
+
+/**
+ * @section 18 - Parallel processing of large buffers test.
+ */
+UNIT_TEST(test180, "splitChunks - Test chunks are split on character boundaries.")
+
+    std::string large{};
+    while (large.length() < 4 * utf8::parallelThreshold)
+        large += "Stra\u00DFe \u0440\u0443\u0441 \u2B61 \U0001F0D3 ";
+
+    const std::vector<std::string_view> chunks{utf8::splitChunks(large, 7)};
+    REQUIRE(chunks.size() == 7)
+
+    std::string joined{};
+    bool boundaries{true};
+    for (const auto & chunk : chunks)
+    {
+        boundaries = boundaries && ((chunk.front() & 0xC0) != 0x80);
+        joined += chunk;
+    }
+    REQUIRE(boundaries == true)
+    REQUIRE(joined.compare(large) == 0)
+    REQUIRE(utf8::splitChunks("", 4).size() == 1)
+
+NEXT_CASE(test181, "validateParallel - Test large buffers match the serial result.")
+
+    REQUIRE(utf8::validateParallel(large, 4) == true)
+    REQUIRE(utf8::findInvalidParallel(large, 4) == std::string_view::npos)
+
+    std::string broken{large};
+    const size_t bad{broken.find('S', 3 * utf8::parallelThreshold)};
+    broken[bad] = (char)0xFF;
+    broken[bad + 30] = (char)0xC3;
+    REQUIRE(utf8::validateParallel(broken, 4) == false)
+    REQUIRE(utf8::findInvalidParallel(broken, 4) == bad)
+    REQUIRE(utf8::findInvalidParallel(broken, 4) == utf8::findInvalid(broken))
+
+NEXT_CASE(test182, "charCountParallel - Test large buffers match the serial result.")
+
+    REQUIRE(utf8::charCountParallel(large, 4) == utf8::charCount(large))
+
+    size_t malformed{};
+    size_t serialMalformed{};
+    const size_t count{utf8::charCountParallel(broken, malformed, 4)};
+    REQUIRE(count == utf8::charCount(broken, serialMalformed))
+    REQUIRE(malformed == serialMalformed)
+    REQUIRE(malformed == 2)
+    REQUIRE(utf8::charCountParallel(large, malformed) == utf8::charCount(large))
+    REQUIRE(malformed == 0)
+
+NEXT_CASE(test183, "toUpperCopyParallel - Test large buffers match the serial result.")
+
+    REQUIRE(utf8::toUpperCopyParallel(large, 4).compare(utf8::toUpperCopy(large)) == 0)
+    REQUIRE(utf8::toLowerCopyParallel(broken, 4).compare(utf8::toLowerCopy(broken)) == 0)
+    REQUIRE(utf8::caseFoldParallel(large, 4).compare(utf8::caseFold(large)) == 0)
+    REQUIRE(utf8::toUpperCopyParallel("stra\u00DFe", 4).compare("STRASSE") == 0)
+
+END_TEST
+
+
+/**
+ * @section 19 - Kernel block boundaries test.
+ */
+UNIT_TEST(test190, "useCharacterRefs - Test references at every position of a long run.")
+
+    bool matched{true};
+    for (size_t pos{}; pos < 150; ++pos)
+    {
+        std::string buffer(150, 'x');
+        buffer.replace(pos, 1, "\u00A9");
+        const std::string expected{buffer.substr(0, pos) + "&#169;" + buffer.substr(pos + 2)};
+        utf8::useCharacterRefs(buffer);
+        matched = matched && (buffer.compare(expected) == 0);
+
+        std::string control(150, 'x');
+        control[pos] = '\t';
+        matched = matched && (utf8::characterRefsLength(control) == 149 + 4);
+    }
+    REQUIRE(matched == true)
+
+NEXT_CASE(test191, "charCount - Test characters at every position of a long run.")
+
+    matched = true;
+    for (size_t pos{}; pos < 150; ++pos)
+    {
+        std::string buffer(150, 'x');
+        buffer.replace(pos, 1, "\U0001F0D3");
+        matched = matched && (utf8::charCount(buffer) == 150);
+        matched = matched && (utf8::findInvalid(buffer) == std::string_view::npos);
+
+        utf8::makeLower(buffer);
+        matched = matched && (buffer.compare(std::string(pos, 'x') + "\U0001F0D3" + std::string(149 - pos, 'x')) == 0);
+    }
+    REQUIRE(matched == true)
+
+END_TEST
+
+
+/**
+ * @section 20 - Code point iterator test.
+ */
+UNIT_TEST(test200, "codePoints - Test iterating forwards.")
+
+    static_assert(std::ranges::bidirectional_range<utf8::CodePoints>);
+    static_assert(std::ranges::borrowed_range<utf8::CodePoints>);
+
+    const std::u32string expected{U"Hello \u00A9 \u00F6 \u2B61 \U0001F0D3"};
+    std::u32string decoded{};
+    for (char32_t unicode : utf8::codePoints(asciiUtf8))
+        decoded += unicode;
+
+    REQUIRE(decoded.compare(expected) == 0)
+    REQUIRE(std::ranges::distance(utf8::codePoints(asciiUtf8)) == 13)
+    REQUIRE(std::ranges::count(utf8::codePoints(asciiUtf8), U' ') == 4)
+
+NEXT_CASE(test201, "codePoints - Test iterating backwards.")
+
+    decoded.clear();
+    for (char32_t unicode : utf8::codePoints(asciiUtf8) | std::views::reverse)
+        decoded += unicode;
+
+    REQUIRE(decoded.compare(std::u32string{expected.rbegin(), expected.rend()}) == 0)
+
+NEXT_CASE(test202, "codePoints - Test byte offsets.")
+
+    const utf8::CodePoints points{asciiUtf8};
+    auto it{std::ranges::find(points, U'\u2B61')};
+    REQUIRE(it.offset() == 12)
+    REQUIRE(it.size() == 3)
+    REQUIRE(it.bytes().compare(upArrowData) == 0)
+    REQUIRE((++it).offset() == 15)
+    REQUIRE((--it).offset() == 12)
+    REQUIRE(std::prev(points.end()).offset() == 16)
+
+NEXT_CASE(test203, "codePoints - Test invalid bytes are replaced one at a time.")
+
+    const char brokenData[]{ 0x41, (char)0xE2, (char)0x82, 0x42, (char)0x80, (char)0x80, (char)0x80, (char)0x80, (char)0xC3, (char)0xB6, (char)0xF0, 0 };
+    const std::u32string replaced{U"A\uFFFD\uFFFDB\uFFFD\uFFFD\uFFFD\uFFFD\u00F6\uFFFD"};
+
+    decoded.clear();
+    for (char32_t unicode : utf8::codePoints(brokenData))
+        decoded += unicode;
+    REQUIRE(decoded.compare(replaced) == 0)
+
+    decoded.clear();
+    for (char32_t unicode : utf8::codePoints(brokenData) | std::views::reverse)
+        decoded += unicode;
+    REQUIRE(decoded.compare(std::u32string{replaced.rbegin(), replaced.rend()}) == 0)
+
+    auto invalid{utf8::codePoints(brokenData).begin()};
+    REQUIRE((++invalid).valid() == false)
+    REQUIRE(invalid.size() == 1)
+
+END_TEST
+
+
+/**
+ * @section 21 - Reverse decoding and truncation test.
+ */
+UNIT_TEST(test210, "prevCharStart - Test stepping back over characters.")
+
+    const std::string_view buffer{asciiUtf8};
+    REQUIRE(utf8::prevCharStart(buffer, 20) == 16)
+    REQUIRE(utf8::prevCharStart(buffer, 16) == 15)
+    REQUIRE(utf8::prevCharStart(buffer, 15) == 12)
+    REQUIRE(utf8::prevCharStart(buffer, 1) == 0)
+
+    const char brokenData[]{ 0x41, (char)0x80, (char)0x80, (char)0x80, (char)0x80, (char)0xE2, (char)0x82, 0 };
+    REQUIRE(utf8::prevCharStart(brokenData, 7) == 6)
+    REQUIRE(utf8::prevCharStart(brokenData, 5) == 4)
+
+NEXT_CASE(test211, "decodePrev - Test decoding backwards.")
+
+    size_t pos{buffer.length()};
+    REQUIRE(utf8::decodePrev(buffer, pos) == 0x1F0D3)
+    REQUIRE(pos == 16)
+    REQUIRE(utf8::decodePrev(buffer, pos) == U' ')
+    REQUIRE(utf8::decodePrev(buffer, pos) == 0x2B61)
+    REQUIRE(pos == 12)
+
+    pos = 7;
+    REQUIRE(utf8::decodePrev(brokenData, pos) == utf8::replacementCharacter)
+    REQUIRE(pos == 6)
+
+NEXT_CASE(test212, "CodePoints - Test reverse iterator.")
+
+    const utf8::CodePoints points{asciiUtf8};
+    std::u32string decoded{points.rbegin(), points.rend()};
+    REQUIRE(decoded.compare(U"\U0001F0D3 \u2B61 \u00F6 \u00A9 olleH") == 0)
+    REQUIRE(points.rbegin().base().offset() == 20)
+
+NEXT_CASE(test213, "truncateToBytes - Test cutting on a character boundary.")
+
+    REQUIRE(utf8::truncateToBytes(buffer, 100).compare(buffer) == 0)
+    REQUIRE(utf8::truncateToBytes(buffer, 20).length() == 20)
+    REQUIRE(utf8::truncateToBytes(buffer, 19).length() == 16)
+    REQUIRE(utf8::truncateToBytes(buffer, 17).length() == 16)
+    REQUIRE(utf8::truncateToBytes(buffer, 14).length() == 12)
+    REQUIRE(utf8::truncateToBytes(buffer, 8).length() == 8)
+    REQUIRE(utf8::truncateToBytes(buffer, 7).length() == 6)
+    REQUIRE(utf8::truncateToBytes(buffer, 0).empty() == true)
+    REQUIRE(utf8::truncateToBytes(brokenData, 3).length() == 3)
+    REQUIRE(utf8::truncateToBytes(brokenData, 6).length() == 6)
+
+NEXT_CASE(test214, "truncateToChars - Test cutting after a number of characters.")
+
+    REQUIRE(utf8::truncateToChars(buffer, 100).compare(buffer) == 0)
+    REQUIRE(utf8::truncateToChars(buffer, 13).length() == 20)
+    REQUIRE(utf8::truncateToChars(buffer, 12).length() == 16)
+    REQUIRE(utf8::truncateToChars(buffer, 7).length() == 8)
+    REQUIRE(utf8::truncateToChars(buffer, 0).empty() == true)
+    REQUIRE(utf8::truncateToChars(brokenData, 3).length() == 3)
+
+END_TEST
+
+
+/**
+ * @section 22 - Indexed string test.
+ */
+UNIT_TEST(test220, "IndexedString - Test character to byte offset lookup.")
+
+    std::string large{};
+    for (int i{}; i < 100; ++i)
+        large += asciiUtf8;
+
+    const utf8::IndexedString indexed{large};
+    REQUIRE(indexed.length() == 1300)
+    REQUIRE(indexed.size() == 2000)
+    REQUIRE(indexed.byteOffset(0) == 0)
+    REQUIRE(indexed.byteOffset(12) == 16)
+    REQUIRE(indexed.byteOffset(13 * 57 + 11) == 20 * 57 + 15)
+    REQUIRE(indexed.byteOffset(1300) == 2000)
+    REQUIRE(indexed.byteOffset(1301) == std::string::npos)
+    REQUIRE(indexed.at(13 * 99 + 10) == 0x2B61)
+
+NEXT_CASE(test221, "IndexedString - Test byte offset to character lookup.")
+
+    REQUIRE(indexed.charIndex(0) == 0)
+    REQUIRE(indexed.charIndex(17) == 12)
+    REQUIRE(indexed.charIndex(20 * 57 + 13) == 13 * 57 + 10)
+    REQUIRE(indexed.charIndex(2000) == 1300)
+
+NEXT_CASE(test222, "IndexedString - Test appending updates the index.")
+
+    utf8::IndexedString text{std::string(200, 'x')};
+    REQUIRE(text.length() == 200)
+
+    text.append(std::string_view{clubs3Data}.substr(0, 2));
+    REQUIRE(text.length() == 202)
+
+    text.append(std::string_view{clubs3Data}.substr(2));
+    REQUIRE(text.length() == 201)
+    REQUIRE(text.at(200) == 0x1F0D3)
+    REQUIRE(text.byteOffset(201) == 204)
+
+    text.append(asciiUtf8);
+    REQUIRE(text.length() == 214)
+    REQUIRE(text.charIndex(204 + 17) == 213)
+
+END_TEST
+
+
+/**
+ * @section 23 - UTF-16 conversion test.
+ */
+UNIT_TEST(test230, "utf16Length - Test ASCII & UTF-8.")
+
+    const std::u16string expected{u"Hello \u00A9 \u00F6 \u2B61 \U0001F0D3"};
+    REQUIRE(expected.length() == 14)
+    REQUIRE(utf8::utf16Length(asciiUtf8) == 14)
+    REQUIRE(utf8::utf16Length("") == 0)
+
+NEXT_CASE(test231, "decode - Test UTF-8 to UTF-16 with a surrogate pair.")
+
+    char16_t output[32]{};
+    utf8::ConvertResult result{utf8::decode(asciiUtf8, output, 32)};
+    REQUIRE(result.consumed == asciiUtf8.length())
+    REQUIRE(result.produced == 14)
+    REQUIRE(result.error == std::string_view::npos)
+    REQUIRE(expected.compare(0, 14, output, 14) == 0)
+
+NEXT_CASE(test232, "decode - Test a surrogate pair is not split by the capacity.")
+
+    result = utf8::decode(asciiUtf8, output, 13);
+    REQUIRE(result.consumed == 16)
+    REQUIRE(result.produced == 12)
+    REQUIRE(result.error == std::string_view::npos)
+
+    const char brokenData[]{ 0x41, (char)0xED, (char)0xA0, (char)0x80, 0 };
+    result = utf8::decode(brokenData, output, 32);
+    REQUIRE(result.produced == 1)
+    REQUIRE(result.error == 1)
+
+NEXT_CASE(test233, "encode - Test UTF-16 to UTF-8 with a surrogate pair.")
+
+    REQUIRE(utf8::encodedLength(expected) == asciiUtf8.length())
+
+    char bytes[32]{};
+    result = utf8::encode(expected, bytes, 32);
+    REQUIRE(result.consumed == 14)
+    REQUIRE(result.produced == asciiUtf8.length())
+    REQUIRE(result.error == std::string_view::npos)
+    REQUIRE(asciiUtf8.compare(0, std::string::npos, bytes, result.produced) == 0)
+
+NEXT_CASE(test234, "encode - Test unpaired surrogates.")
+
+    const std::u16string unpaired{u"AB\xD83C" u"C"};
+    result = utf8::encode(unpaired, bytes, 32);
+    REQUIRE(result.consumed == 2)
+    REQUIRE(result.produced == 2)
+    REQUIRE(result.error == 2)
+
+    const std::u16string lowFirst{u"A\xDCD3\xD83C"};
+    REQUIRE(utf8::encode(lowFirst, bytes, 32).error == 1)
+    REQUIRE(utf8::encodedLength(lowFirst) == 1)
+
+NEXT_CASE(test235, "decode - Test long runs round trip.")
+
+    std::string large{};
+    for (int i{}; i < 500; ++i)
+        large += (i % 3) ? "Hello " : "\u0416\u0416\u0416\u0416\u0416\u0416\u0416\u0416\u0416 \U0001F0D3 ";
+
+    std::u16string wide(utf8::utf16Length(large), u'\0');
+    result = utf8::decode(large, wide.data(), wide.length());
+    REQUIRE(result.consumed == large.length())
+    REQUIRE(result.produced == wide.length())
+
+    std::string narrow(utf8::encodedLength(wide), '\0');
+    REQUIRE(narrow.length() == large.length())
+    result = utf8::encode(wide, narrow.data(), narrow.length());
+    REQUIRE(result.produced == large.length())
+    REQUIRE(narrow.compare(large) == 0)
+
+END_TEST
+
+
+/**
+ * @section 24 - Error handling policy test.
+ */
+UNIT_TEST(test240, "charCount - Test counts with each policy.")
+
+    const char brokenData[]{ 0x41, (char)0xE2, (char)0x82, 0x42, (char)0xC3, (char)0xB6, (char)0xFF, 0 };
+    REQUIRE(utf8::charCount<utf8::Strict>(brokenData) == 1)
+    REQUIRE(utf8::charCount<utf8::Replace>(brokenData) == 6)
+    REQUIRE(utf8::charCount<utf8::Skip>(brokenData) == 3)
+    REQUIRE(utf8::charCount<utf8::Latin1>(brokenData) == 6)
+    REQUIRE(utf8::charCount<utf8::Strict>(asciiUtf8) == 13)
+
+NEXT_CASE(test241, "decode - Test Strict stops at the first invalid byte.")
+
+    char32_t output[16]{};
+    utf8::ConvertResult result{utf8::decode<utf8::Strict>(brokenData, output, 16)};
+    REQUIRE(result.consumed == 1)
+    REQUIRE(result.produced == 1)
+    REQUIRE(result.error == 1)
+
+NEXT_CASE(test242, "decode - Test Replace substitutes U+FFFD for each invalid byte.")
+
+    result = utf8::decode<utf8::Replace>(brokenData, output, 16);
+    REQUIRE(result.consumed == 7)
+    REQUIRE(result.produced == 6)
+    REQUIRE(result.error == 1)
+    REQUIRE(std::u32string_view(output, 6).compare(U"A\uFFFD\uFFFDB\u00F6\uFFFD") == 0)
+
+NEXT_CASE(test243, "decode - Test Skip drops invalid bytes.")
+
+    result = utf8::decode<utf8::Skip>(brokenData, output, 16);
+    REQUIRE(result.consumed == 7)
+    REQUIRE(result.produced == 3)
+    REQUIRE(result.error == 1)
+    REQUIRE(std::u32string_view(output, 3).compare(U"AB\u00F6") == 0)
+
+NEXT_CASE(test244, "decode - Test Latin1 passes invalid bytes through.")
+
+    result = utf8::decode<utf8::Latin1>(brokenData, output, 16);
+    REQUIRE(result.produced == 6)
+    REQUIRE(std::u32string_view(output, 6).compare(U"A\u00E2\u0082B\u00F6\u00FF") == 0)
+
+    char16_t units[16]{};
+    result = utf8::decode<utf8::Latin1>(brokenData, units, 16);
+    REQUIRE(result.produced == 6)
+    REQUIRE(std::u16string_view(units, 6).compare(u"A\u00E2\u0082B\u00F6\u00FF") == 0)
+
+NEXT_CASE(test245, "decode - Test a full buffer stops before an invalid byte.")
+
+    result = utf8::decode<utf8::Replace>(brokenData, output, 2);
+    REQUIRE(result.consumed == 2)
+    REQUIRE(result.produced == 2)
+
+    result = utf8::decode<utf8::Replace>(brokenData, units, 1);
+    REQUIRE(result.consumed == 1)
+    REQUIRE(result.produced == 1)
+    REQUIRE(result.error == std::string_view::npos)
+
+END_TEST
+
+
+/**
+ * @section 25 - Sanitize test.
+ */
+UNIT_TEST(test250, "sanitize - Test a valid buffer is unchanged.")
+
+    std::string buffer{asciiUtf8};
+    const char * data{buffer.data()};
+    REQUIRE(utf8::sanitize(buffer) == 0)
+    REQUIRE(buffer.compare(asciiUtf8) == 0)
+    REQUIRE(buffer.data() == data)
+
+NEXT_CASE(test251, "sanitize - Test Replace substitutes U+FFFD.")
+
+    const char brokenData[]{ 0x41, (char)0xE2, (char)0x82, 0x42, (char)0xC3, (char)0xB6, (char)0xFF, 0 };
+    buffer = brokenData;
+    REQUIRE(utf8::sanitize(buffer) == 3)
+    REQUIRE(buffer.compare("A\uFFFD\uFFFDB\u00F6\uFFFD") == 0)
+    REQUIRE(utf8::validate(buffer) == true)
+
+NEXT_CASE(test252, "sanitize - Test Skip drops invalid bytes in place.")
+
+    buffer = brokenData;
+    data = buffer.data();
+    REQUIRE(utf8::sanitize<utf8::Skip>(buffer) == 3)
+    REQUIRE(buffer.compare("AB\u00F6") == 0)
+    REQUIRE(buffer.data() == data)
+
+NEXT_CASE(test253, "sanitize - Test Latin1 converts invalid bytes.")
+
+    buffer = brokenData;
+    REQUIRE(utf8::sanitize<utf8::Latin1>(buffer) == 3)
+    REQUIRE(buffer.compare("A\u00E2\u0082B\u00F6\u00FF") == 0)
+
+    buffer = std::string(1000, 'x') + "\xC0\x80" + asciiUtf8;
+    REQUIRE(utf8::sanitize(buffer) == 2)
+    REQUIRE(buffer.compare(std::string(1000, 'x') + "\uFFFD\uFFFD" + asciiUtf8) == 0)
+
+END_TEST
+
+
+/**
+ * @section 26 - ISO/IEC 8859-1 conversion test.
+ */
+UNIT_TEST(test260, "latin1ToUtf8 - Test ASCII & ISO/IEC 8859-1.")
+
+    const char latin1Data[]{ 'c', 'a', 'f', (char)0xE9, ' ', (char)0xA9, 0 };
+    REQUIRE(utf8::latin1ToUtf8Length(latin1Data) == 8)
+    REQUIRE(utf8::latin1ToUtf8(latin1Data).compare("caf\u00E9 \u00A9") == 0)
+
+    char output[8]{};
+    utf8::ConvertResult result{utf8::latin1ToUtf8(latin1Data, output, 4)};
+    REQUIRE(result.consumed == 3)
+    REQUIRE(result.produced == 3)
+
+NEXT_CASE(test261, "utf8ToLatin1 - Test lossless conversion.")
+
+    result = utf8::utf8ToLatin1("caf\u00E9 \u00A9", output, 8);
+    REQUIRE(result.consumed == 8)
+    REQUIRE(result.produced == 6)
+    REQUIRE(result.error == std::string_view::npos)
+    REQUIRE(std::string_view(output, 6).compare(latin1Data) == 0)
+
+    result = utf8::utf8ToLatin1(asciiUtf8, output, 8);
+    REQUIRE(result.produced == 8)
+    REQUIRE(result.error == std::string_view::npos)
+
+    char wide[32]{};
+    result = utf8::utf8ToLatin1(asciiUtf8, wide, 32);
+    REQUIRE(result.consumed == 12)
+    REQUIRE(result.produced == 10)
+    REQUIRE(result.error == 12)
+
+NEXT_CASE(test262, "utf8ToLatin1 - Test lossy conversion.")
+
+    result = utf8::utf8ToLatin1(asciiUtf8, wide, 32, '?');
+    REQUIRE(result.consumed == 20)
+    REQUIRE(result.produced == 13)
+    REQUIRE(result.error == 12)
+    REQUIRE(std::string_view(wide, 13).compare("Hello \xA9 \xF6 ? ?") == 0)
+
+    const char brokenData[]{ 0x41, (char)0xC3, 0x42, 0 };
+    result = utf8::utf8ToLatin1(brokenData, wide, 32, '?');
+    REQUIRE(std::string_view(wide, result.produced).compare("A?B") == 0)
+
+NEXT_CASE(test263, "latin1ToUtf8 - Test long runs round trip.")
+
+    std::string latin1{};
+    for (int i{}; i < 256; ++i)
+        latin1 += std::string(i % 40, 'x') + (char)i;
+
+    const std::string utf8Text{utf8::latin1ToUtf8(latin1)};
+    REQUIRE(utf8::validate(utf8Text) == true)
+    REQUIRE(utf8::charCount(utf8Text) == latin1.length())
+
+    std::string back(latin1.length(), '\0');
+    result = utf8::utf8ToLatin1(utf8Text, back.data(), back.length());
+    REQUIRE(result.error == std::string_view::npos)
+    REQUIRE(back.compare(latin1) == 0)
+
+END_TEST
+
+
+/**
+ * @section 27 - HTML & XML escaping test.
+ */
+UNIT_TEST(test270, "escapeCopy - Test HTML text mode.")
+
+    const std::string markup{"<a href=\"x\">Tom & Jerry's</a>"};
+    REQUIRE(utf8::escapeCopy(markup).compare("&lt;a href=\"x\"&gt;Tom &amp; Jerry's&lt;/a&gt;") == 0)
+    REQUIRE(utf8::escapedLength(markup) == 45)
+    REQUIRE(utf8::escapeCopy(asciiUtf8).compare(asciiUtf8) == 0)
+    REQUIRE(utf8::escapeCopy("a\tb\nc\rd\x01").compare("a\tb\nc\rd&#1;") == 0)
+
+NEXT_CASE(test271, "escapeCopy - Test HTML attribute & XML modes.")
+
+    utf8::EscapeOptions options{utf8::EscapeMode::htmlAttribute};
+    REQUIRE(utf8::escapeCopy(markup, options).compare("&lt;a href=&quot;x&quot;&gt;Tom &amp; Jerry&#39;s&lt;/a&gt;") == 0)
+
+    options.mode = utf8::EscapeMode::xml;
+    REQUIRE(utf8::escapeCopy(markup, options).compare("&lt;a href=&quot;x&quot;&gt;Tom &amp; Jerry&apos;s&lt;/a&gt;") == 0)
+
+NEXT_CASE(test272, "escapeCopy - Test named, decimal & hexadecimal references.")
+
+    options = { .asciiOnly = true };
+    REQUIRE(utf8::escapeCopy(asciiUtf8, options).compare("Hello &#169; &#246; &#11105; &#127187;") == 0)
+
+    options.hexadecimal = true;
+    REQUIRE(utf8::escapeCopy(asciiUtf8, options).compare("Hello &#xA9; &#xF6; &#x2B61; &#x1F0D3;") == 0)
+
+    options.namedEntities = true;
+    REQUIRE(utf8::escapeCopy(asciiUtf8, options).compare("Hello &copy; &ouml; &#x2B61; &#x1F0D3;") == 0)
+
+    options.mode = utf8::EscapeMode::xml;
+    REQUIRE(utf8::escapeCopy(asciiUtf8, options).compare("Hello &#xA9; &#xF6; &#x2B61; &#x1F0D3;") == 0)
+
+NEXT_CASE(test273, "escape - Test invalid bytes & in place escaping.")
+
+    const char brokenData[]{ 'a', (char)0xE9, '<', (char)0xC3, 0 };
+    REQUIRE(utf8::escapeCopy(brokenData).compare("a&#233;&lt;&#195;") == 0)
+    REQUIRE(utf8::escapeCopy(brokenData, { .namedEntities = true }).compare("a&eacute;&lt;&Atilde;") == 0)
+
+    std::string buffer{std::string(100, 'x') + "&" + std::string(100, 'y')};
+    utf8::escape(buffer);
+    REQUIRE(buffer.compare(std::string(100, 'x') + "&amp;" + std::string(100, 'y')) == 0)
+
+    buffer = asciiUtf8;
+    utf8::escape(buffer);
+    REQUIRE(buffer.compare(asciiUtf8) == 0)
+
+    char output[64]{};
+    const char * last{utf8::writeEscaped("\"'", output, { utf8::EscapeMode::xml })};
+    REQUIRE(std::string_view(output, last - output).compare("&quot;&apos;") == 0)
+
+END_TEST
+
+
+/**
+ * @section 28 - HTML & XML unescaping test.
+ */
+UNIT_TEST(test280, "unescapeCopy - Test numeric references.")
+
+    REQUIRE(utf8::unescapeCopy("Hello &#169; &#xF6; &#X2B61; &#127187;").compare(asciiUtf8) == 0)
+    REQUIRE(utf8::unescapeCopy("&#0;&#xD800;&#1114112;&#99999999999;").compare("\uFFFD\uFFFD\uFFFD\uFFFD") == 0)
+    REQUIRE(utf8::unescapeCopy("&#;&#x;&#65&#-5;").compare("&#;&#x;&#65&#-5;") == 0)
+
+NEXT_CASE(test281, "unescapeCopy - Test named references.")
+
+    REQUIRE(utf8::unescapeCopy("&lt;a href=&quot;x&quot;&gt;Tom &amp; Jerry&apos;s&lt;/a&gt;").compare("<a href=\"x\">Tom & Jerry's</a>") == 0)
+    REQUIRE(utf8::unescapeCopy("&copy;&ouml;&thetasym;&frac14;").compare("\u00A9\u00F6\u03D1\u00BC") == 0)
+    REQUIRE(utf8::unescapeCopy("&copy &nope; &thetasyms; &amp").compare("&copy &nope; &thetasyms; &amp") == 0)
+
+NEXT_CASE(test282, "unescape - Test in place & round trip.")
+
+    std::string buffer{std::string(100, 'x') + "&amp;" + std::string(100, 'y')};
+    utf8::unescape(buffer);
+    REQUIRE(buffer.compare(std::string(100, 'x') + "&" + std::string(100, 'y')) == 0)
+
+    buffer = utf8::escapeCopy(asciiUtf8, { .namedEntities = true, .asciiOnly = true });
+    utf8::unescape(buffer);
+    REQUIRE(buffer.compare(asciiUtf8) == 0)
+
+    const std::string markup{"<p class='x'>\"A\" & \u00A9</p>"};
+    REQUIRE(utf8::unescapeCopy(utf8::escapeCopy(markup, { utf8::EscapeMode::xml })).compare(markup) == 0)
+
+    char output[32]{};
+    const char * last{utf8::writeUnescaped("&lt;&gt;", output)};
+    REQUIRE(std::string_view(output, last - output).compare("<>") == 0)
+
+END_TEST
+
+
+/**
+ * @section 29 - Output sink test.
+ */
+UNIT_TEST(test290, "Sink - Test std::string and BufferSink.")
+
+    std::string text{"x"};
+    REQUIRE(utf8::unicodeToUtf8(0x1F0D3, text) == true)
+    REQUIRE(utf8::unicodeToUtf8(-1, text) == false)
+    utf8::writeEscaped("<&>", text);
+    utf8::toUpperCopy("stra\u00DFe", text);
+    REQUIRE(text.compare(std::string{"x"} + clubs3Data + "&lt;&amp;&gt;STRASSE") == 0)
+
+    char output[8]{};
+    utf8::BufferSink buffer{output, sizeof(output)};
+    utf8::writeCharacterRefs("a\u00A9", buffer);
+    REQUIRE(buffer.view().compare("a&#169;") == 0)
+    REQUIRE(buffer.overflowed() == false)
+    utf8::writeUnescaped("&lt;&gt;", buffer);
+    REQUIRE(buffer.view().compare("a&#169;<") == 0)
+    REQUIRE(buffer.overflowed() == true)
+
+NEXT_CASE(test291, "Sink - Test VectorSink and CallbackSink.")
+
+    std::vector<unsigned char> bytes{};
+    utf8::VectorSink vector{bytes};
+    utf8::latin1ToUtf8("caf\xE9", vector);
+    REQUIRE(bytes.size() == 5)
+    REQUIRE(bytes[3] == 0xC3)
+    REQUIRE(bytes[4] == 0xA9)
+
+    size_t calls{};
+    std::string gathered{};
+    utf8::CallbackSink callback{[&](std::string_view run) { ++calls; gathered += run; }};
+    const std::u32string unicodes(3000, U'\U0001F0D3');
+    const utf8::ConvertResult result{utf8::encode(unicodes, callback)};
+    REQUIRE(result.consumed == 3000)
+    REQUIRE(result.produced == 12000)
+    REQUIRE(calls > 1)
+    REQUIRE(gathered.length() == 12000)
+    REQUIRE(gathered.compare(0, 4, clubs3Data) == 0)
+
+    const std::u16string units{u"a\xD800" u"b"};
+    gathered.clear();
+    REQUIRE(utf8::encode(units, callback).error == 1)
+    REQUIRE(gathered.compare("a") == 0)
+
+NEXT_CASE(test292, "Sink - Test FileSink and FdSink.")
+
+    std::FILE * file{std::tmpfile()};
+    REQUIRE(file != nullptr)
+    {
+        utf8::FileSink stream{file};
+        utf8::caseFold("\u00C9T\u00C9", stream);
+        REQUIRE(stream.good() == true)
+
+        utf8::FdSink descriptor{fileno(file), 4};
+        std::fflush(file);
+        utf8::toLowerCopy(" AND ", descriptor);
+        utf8::writeEscaped("\"\u00A9\"", descriptor, { utf8::EscapeMode::xml, true, false, true });
+        REQUIRE(descriptor.flush() == true)
+    }
+
+    char contents[32]{};
+    std::rewind(file);
+    const size_t read{std::fread(contents, 1, sizeof(contents), file)};
+    std::fclose(file);
+    REQUIRE(std::string_view(contents, read).compare("\u00E9t\u00E9 and &quot;&#169;&quot;") == 0)
+
+END_TEST
+
+
+/**
+ * @section 30 - Allocator aware test.
+ */
+UNIT_TEST(test300, "pmr - Test strings allocated from an arena.")
+
+    // Any allocation beyond the arena throws, as there is no upstream.
+    char arena[4096];
+    std::pmr::monotonic_buffer_resource resource{arena, sizeof(arena), std::pmr::null_memory_resource()};
+
+    const std::string text(100, 'a');
+    const std::pmr::string upper{utf8::pmr::toUpperCopy(text, &resource)};
+    REQUIRE(upper.compare(std::string(100, 'A')) == 0)
+    REQUIRE(upper.get_allocator().resource() == &resource)
+
+    REQUIRE(utf8::pmr::toLowerCopy("\u00C9T\u00C9 " + text, &resource).compare("\u00E9t\u00E9 " + text) == 0)
+    REQUIRE(utf8::pmr::caseFold("STRASSE stra\u00DFe", &resource).compare("strasse strasse") == 0)
+    REQUIRE(utf8::pmr::unicodeToUtf8(0x1F0D3, &resource).compare(clubs3Data) == 0)
+    REQUIRE(utf8::pmr::latin1ToUtf8("caf\xE9 " + text, &resource).compare("caf\u00E9 " + text) == 0)
+    REQUIRE(utf8::pmr::useCharacterRefs("\u00A9" + text, &resource).compare("&#169;" + text) == 0)
+    REQUIRE(utf8::pmr::escapeCopy("<" + text + ">", {}, &resource).compare("&lt;" + text + "&gt;") == 0)
+    REQUIRE(utf8::pmr::unescapeCopy("&lt;" + text + "&gt;", &resource).compare("<" + text + ">") == 0)
+
+NEXT_CASE(test301, "unicodeToUtf8Vector - Test with an allocator.")
+
+    const std::pmr::vector<unsigned char> bytes{utf8::pmr::unicodeToUtf8Vector<unsigned char>(0x2B61, &resource)};
+    REQUIRE(bytes.size() == 3)
+    REQUIRE(bytes[0] == 0xE2)
+    REQUIRE(bytes.get_allocator().resource() == &resource)
+
+    const std::vector<char> chars{utf8::unicodeToUtf8Vector<char>(0xA9, std::allocator<char>{})};
+    REQUIRE(std::string(chars.begin(), chars.end()).compare(copyrightData) == 0)
+
+    const utf8::String<std::allocator<char>> copy{utf8::escapeCopy("&", {}, std::allocator<char>{})};
+    REQUIRE(copy.compare("&amp;") == 0)
+
+END_TEST
+
+
+/**
+ * @section 31 - Compile time test.
+ */
+UNIT_TEST(test310, "constant - Test validation and counting at compile time.")
+
+    static_assert(utf8::constant::validate("A©⭡\U0001F0D3"));
+    static_assert(!utf8::constant::validate("ab\xC0\xAF"));
+    static_assert(utf8::constant::findInvalid("ab\xED\xA0\x80") == 2);
+    static_assert(utf8::constant::charCount("A©⭡\U0001F0D3") == 4);
+
+    const std::string_view samples[]{ "", "A©⭡\U0001F0D3", "ab\xC0\xAF", "\xF4\x90\x80\x80z", "x\xE2\xAD" };
+    for (const std::string_view sample : samples)
+    {
+        REQUIRE(utf8::constant::validate(sample) == utf8::validate(sample))
+        REQUIRE(utf8::constant::findInvalid(sample) == utf8::findInvalid(sample))
+        REQUIRE(utf8::constant::charCount(sample) == utf8::charCount(sample))
+    }
+
+NEXT_CASE(test311, "constant - Test decoding and encoding at compile time.")
+
+    constexpr auto decoded = []
+    {
+        std::array<char32_t, 4> values{};
+        utf8::constant::decode("A©⭡\U0001F0D3", values.data(), values.size());
+        return values;
+    }();
+    static_assert(decoded[3] == 0x1F0D3);
+
+    constexpr auto encoded = []
+    {
+        std::array<char, 5> bytes{};
+        constexpr char32_t values[]{ 0x1F0D3 };
+        utf8::constant::encode(values, bytes.data(), bytes.size());
+        return bytes;
+    }();
+    REQUIRE(std::string_view{encoded.data()}.compare(clubs3Data) == 0)
+
+    char32_t values[8]{};
+    utf8::ConvertResult result{utf8::constant::decode("ab\xC0\xAF", values, 8)};
+    REQUIRE(result.consumed == 2)
+    REQUIRE(result.produced == 2)
+    REQUIRE(result.error == 2)
+
+    result = utf8::constant::decode("A©⭡", values, 2);
+    REQUIRE(result.consumed == 3)
+    REQUIRE(result.produced == 2)
+    REQUIRE(result.error == std::string_view::npos)
+
+    const char32_t invalid[]{ 0x41, 0x2B61, 0xD800, 0x42 };
+    char bytes[8]{};
+    result = utf8::constant::encode(invalid, bytes, 3);
+    REQUIRE(result.consumed == 1)
+    REQUIRE(result.produced == 1)
+    REQUIRE(result.error == std::string_view::npos)
+
+    result = utf8::constant::encode(invalid, bytes, 8);
+    REQUIRE(result.consumed == 2)
+    REQUIRE(result.produced == 4)
+    REQUIRE(result.error == 2)
+
+NEXT_CASE(test312, "Literal - Test literals validated and measured at compile time.")
+
+    using namespace utf8::literals;
+
+    constexpr auto clubs{"\U0001F0D3"_utf8};
+    static_assert(clubs.size() == 4);
+    static_assert(clubs.length() == 1);
+    REQUIRE(clubs.view().compare(clubs3Data) == 0)
+
+    constexpr auto & greeting{utf8::literal<"café ⭡">};
+    static_assert(greeting.size() == 9);
+    static_assert(greeting.length() == 6);
+    REQUIRE(greeting.length() == utf8::charCount(greeting))
+    REQUIRE(std::string{greeting.c_str()}.compare("café ⭡") == 0)
+    REQUIRE(*std::next(greeting.codePoints().begin(), 3) == 0xE9)
+
 END_TEST
 
 
@@ -560,6 +1836,28 @@ int runTests(void)
     RUN_TEST(test70)
     RUN_TEST(test80)
     RUN_TEST(test90)
+    RUN_TEST(test100)
+    RUN_TEST(test110)
+    RUN_TEST(test120)
+    RUN_TEST(test130)
+    RUN_TEST(test140)
+    RUN_TEST(test150)
+    RUN_TEST(test160)
+    RUN_TEST(test170)
+    RUN_TEST(test180)
+    RUN_TEST(test190)
+    RUN_TEST(test200)
+    RUN_TEST(test210)
+    RUN_TEST(test220)
+    RUN_TEST(test230)
+    RUN_TEST(test240)
+    RUN_TEST(test250)
+    RUN_TEST(test260)
+    RUN_TEST(test270)
+    RUN_TEST(test280)
+    RUN_TEST(test290)
+    RUN_TEST(test300)
+    RUN_TEST(test310)
 
     const int err{FINISHED};
     OUTPUT_SUMMARY;
@@ -0,0 +1,337 @@
+/**
+ * @file    utf8tool.cpp
+ * @author  Phil Lockett <phillockett65@gmail.com>
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Process large UTF-8 files using the UTF-8 code Implementation.
+ *
+ * Each file is memory mapped and split into chunks on character boundaries,
+ * which are processed in parallel. Converted output is written to stdout
+ * with a single gathering write of all the chunk buffers.
+ *
+ * Build using:
+ *    g++ -std=c++20 -pthread -c -o utf8tool.o utf8tool.cpp
+ *    g++ -std=c++20 -c -o utf_8.o utf_8.cpp
+ *    g++ -std=c++20 -c -o kernels.o kernels.cpp
+ *    g++ -std=c++20 -pthread -o utf8tool utf8tool.o utf_8.o kernels.o
+ *
+ * Usage:
+ *    ./utf8tool validate|count|upper|lower|fold|escape <file> ...
+ *
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "utf_8.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief A read only memory mapping of a whole file.
+ */
+class MappedFile
+{
+public:
+    MappedFile(const char * path);
+    ~MappedFile(void);
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    bool isOpen(void) const { return open; }
+    std::string_view view(void) const { return std::string_view{(const char *)data, size}; }
+
+private:
+    void * data{};
+    size_t size{};
+    bool open{};
+
+};
+
+/**
+ * @brief Map the file at path into memory.
+ * 
+ * @param path of the file to map.
+ */
+MappedFile::MappedFile(const char * path)
+{
+    const int fd{::open(path, O_RDONLY)};
+    if (fd < 0)
+        return;
+
+    struct stat info{};
+    if (fstat(fd, &info) == 0)
+    {
+        size = info.st_size;
+        if (size == 0)
+            open = true;
+        else
+        {
+            data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED)
+            {
+                madvise(data, size, MADV_SEQUENTIAL);
+                open = true;
+            }
+            else
+                data = nullptr;
+        }
+    }
+
+    close(fd);
+}
+
+/**
+ * @brief Unmap the file.
+ */
+MappedFile::~MappedFile(void)
+{
+    if (data)
+        munmap(data, size);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Split buffer into chunks on character boundaries, one per hardware
+ * thread, but only if each chunk would be at least utf8::parallelThreshold.
+ * 
+ * @param buffer to split.
+ * @return std::vector<std::string_view> the chunks, in order.
+ */
+std::vector<std::string_view> splitChunks(const std::string_view & buffer)
+{
+    const size_t threads{std::max<size_t>(std::thread::hardware_concurrency(), 1)};
+
+    return utf8::splitChunks(buffer, std::clamp<size_t>(buffer.length() / utf8::parallelThreshold, 1, threads));
+}
+
+/**
+ * @brief Run func on every chunk, each in its own thread.
+ * 
+ * @param chunks to process.
+ * @param func callable taking the chunk index.
+ */
+template<typename F>
+void forEachChunk(const std::vector<std::string_view> & chunks, F func)
+{
+    std::vector<std::thread> threads{};
+    for (size_t i{1}; i < chunks.size(); ++i)
+        threads.emplace_back(func, i);
+
+    func(0);
+
+    for (auto & thread : threads)
+        thread.join();
+}
+
+/**
+ * @brief Write all the buffers to stdout in order, gathering them into as few
+ * writes as possible.
+ * 
+ * @param buffers to write.
+ * @return true if all the data was written, false otherwise.
+ */
+bool writeAll(const std::vector<std::string> & buffers)
+{
+    std::vector<iovec> vectors{};
+    for (const auto & buffer : buffers)
+        if (!buffer.empty())
+            vectors.push_back(iovec{(void *)buffer.data(), buffer.length()});
+
+    size_t next{};
+    while (next < vectors.size())
+    {
+        const int count{(int)std::min<size_t>(vectors.size() - next, IOV_MAX)};
+        ssize_t written{writev(STDOUT_FILENO, &vectors[next], count)};
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return false;
+        }
+
+        // Step over the vectors written and adjust for a partial write.
+        while ((next < vectors.size()) && ((size_t)written >= vectors[next].iov_len))
+            written -= vectors[next++].iov_len;
+
+        if (written)
+        {
+            vectors[next].iov_base = (char *)vectors[next].iov_base + written;
+            vectors[next].iov_len -= written;
+        }
+    }
+
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Validate the file and report the offset of the first invalid byte.
+ * 
+ * @param name of the file.
+ * @param buffer holding the file.
+ * @return true if the file is valid UTF-8, false otherwise.
+ */
+bool validateFile(const char * name, const std::string_view & buffer)
+{
+    const size_t invalid{utf8::findInvalidParallel(buffer)};
+    if (invalid != std::string_view::npos)
+    {
+        std::cout << name << ": invalid UTF-8 at byte " << invalid << "\n";
+
+        return false;
+    }
+
+    std::cout << name << ": valid UTF-8\n";
+
+    return true;
+}
+
+/**
+ * @brief Count and report the characters and malformed bytes in the file.
+ * 
+ * @param name of the file.
+ * @param buffer holding the file.
+ * @return true if the file is valid UTF-8, false otherwise.
+ */
+bool countFile(const char * name, const std::string_view & buffer)
+{
+    size_t malformed{};
+    const size_t count{utf8::charCountParallel(buffer, malformed)};
+
+    std::cout << name << ": " << buffer.length() << " bytes, " << count << " characters, " << malformed << " malformed bytes\n";
+
+    return malformed == 0;
+}
+
+/**
+ * @brief Convert every chunk of the file and write the result to stdout.
+ * 
+ * @param buffer holding the file.
+ * @param convert callable generating the converted string from a chunk.
+ * @return true if all the output was written, false otherwise.
+ */
+template<typename F>
+bool convertFile(const std::string_view & buffer, F convert)
+{
+    const std::vector<std::string_view> chunks{splitChunks(buffer)};
+    std::vector<std::string> outputs(chunks.size());
+    forEachChunk(chunks, [&](size_t i) { outputs[i] = convert(chunks[i]); });
+
+    return writeAll(outputs);
+}
+
+/**
+ * @brief The commands that can be applied to the files.
+ */
+constexpr std::string_view commands[]{ "validate", "count", "upper", "lower", "fold", "escape" };
+
+/**
+ * @brief Apply the command to the file.
+ * 
+ * @param command to apply.
+ * @param name of the file.
+ * @return true if successful, false otherwise.
+ */
+bool processFile(const std::string_view & command, const char * name)
+{
+    const MappedFile file{name};
+    if (!file.isOpen())
+    {
+        std::cerr << name << ": " << std::strerror(errno) << "\n";
+
+        return false;
+    }
+
+    const std::string_view buffer{file.view()};
+
+    if (command == "validate")
+        return validateFile(name, buffer);
+
+    if (command == "count")
+        return countFile(name, buffer);
+
+    if (command == "upper")
+        return convertFile(buffer, [](const std::string_view & chunk) { return utf8::toUpperCopy(chunk); });
+
+    if (command == "lower")
+        return convertFile(buffer, [](const std::string_view & chunk) { return utf8::toLowerCopy(chunk); });
+
+    if (command == "fold")
+        return convertFile(buffer, [](const std::string_view & chunk) { return utf8::caseFold(chunk); });
+
+    if (command == "escape")
+        return convertFile(buffer, [](const std::string_view & chunk)
+        {
+            std::string output(utf8::characterRefsLength(chunk), '\0');
+            utf8::writeCharacterRefs(chunk, output.data());
+
+            return output;
+        });
+
+    return false;
+}
+
+
+/**
+ * Process UTF-8 files named on the command line.
+ *
+ * @param  argc - command line argument count.
+ * @param  argv - command line argument vector.
+ * @return error value or 0 if no errors.
+ */
+int main(int argc, char *argv[])
+{
+    const bool known{(argc > 1) && (std::ranges::find(commands, std::string_view{argv[1]}) != std::end(commands))};
+    if ((argc < 3) || !known)
+    {
+        if (argc > 1 && !known)
+            std::cerr << "Unknown command: " << argv[1] << "\n";
+
+        std::cerr << "Usage: " << argv[0] << " validate|count|upper|lower|fold|escape <file> ...\n";
+
+        return 1;
+    }
+
+    int errors{};
+    for (int i{2}; i < argc; ++i)
+        if (!processFile(argv[1], argv[i]))
+            ++errors;
+
+    return errors ? 1 : 0;
+}
@@ -21,10 +21,24 @@
  * Unicode UTF-8 conversion code Implementation.
  */
 
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstdint>
 #include <cstring>
 #include <string_view>
+#include <thread>
+#include <type_traits>
+
+#if __has_include(<unistd.h>)
+#include <cerrno>
+#include <unistd.h>
+#endif
 
 #include "utf_8.h"
+#include "kernels.h"
+#include "casetables.h"
+#include "entitytables.h"
 
 namespace utf8 {
 
@@ -108,6 +122,144 @@ std::string unicodeToUtf8(int unicode)
     return std::string(buffer);
 }
 
+/**
+ * @brief Append a UTF-8 character generated from unicode to a sink.
+ * 
+ * @param unicode value to encode as a UTF-8 character.
+ * @param sink to append the encoded UTF-8 character to.
+ * @return true if unicode could be encoded, false otherwise.
+ */
+bool unicodeToUtf8(int unicode, SinkRef sink)
+{
+    char buffer[4]{};
+
+    // Get UTF-8 length and set first byte with getUtf8Length().
+    const size_t len{getUtf8Length(unicode, buffer[0])};
+
+    if (!len)
+        return false;
+
+    // Set remaining bytes.
+    size_t shift{6 * (len - 1)};
+    for (size_t i{1}; i < len; ++i)
+    {
+        shift -= 6;
+        const int value{(unicode >> shift) & 0x3F};
+        buffer[i] = 0x80 + value;
+    }
+
+    sink.append(buffer, len);
+
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Output sinks.
+
+/**
+ * @brief Sink that only counts the bytes appended.
+ */
+struct CountSink
+{
+    size_t size{};
+
+    void append(const char *, size_t length) { size += length; }
+};
+
+/**
+ * @brief Sink to a buffer known to be large enough, which may also be the
+ * input if the output can never overtake it.
+ */
+struct PointerSink
+{
+    char * output{};
+
+    void append(const char * p, size_t length) { output = std::copy(p, p + length, output); }
+};
+
+/**
+ * @brief Write to the C stream, marking the sink as failed on error.
+ * 
+ * @param p points to the bytes to write.
+ * @param length number of bytes to write.
+ */
+void FileSink::append(const char * p, size_t length)
+{
+    if (std::fwrite(p, 1, length, file) != length)
+        failed = true;
+}
+
+#if __has_include(<unistd.h>)
+/**
+ * @brief Write all of a buffer to a file descriptor, continuing after
+ * partial writes and interruptions.
+ * 
+ * @param fd the file descriptor to write to.
+ * @param p points to the bytes to write.
+ * @param length number of bytes to write.
+ * @return true if all the bytes were written, false otherwise.
+ */
+bool writeAll(int fd, const char * p, size_t length)
+{
+    while (length)
+    {
+        const ssize_t written{::write(fd, p, length)};
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return false;
+        }
+
+        p += written;
+        length -= written;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Gather output into the buffer, writing it when full. Runs too large
+ * for the buffer are written directly.
+ * 
+ * @param p points to the bytes to append.
+ * @param length number of bytes to append.
+ */
+void FdSink::append(const char * p, size_t length)
+{
+    if (used + length > buffer.size())
+        flush();
+
+    if (length >= buffer.size())
+    {
+        if (!writeAll(descriptor, p, length))
+            failed = true;
+
+        return;
+    }
+
+    std::memcpy(buffer.data() + used, p, length);
+    used += length;
+}
+
+/**
+ * @brief Write the gathered output to the file descriptor.
+ * 
+ * @return true if the sink has not failed, false otherwise.
+ */
+bool FdSink::flush(void)
+{
+    if (used && !writeAll(descriptor, buffer.data(), used))
+        failed = true;
+
+    used = 0;
+
+    return !failed;
+}
+#endif
+
 
 ///////////////////////////////////////////////////////////////////////////////
 // UTF-8 to Unicode.
@@ -207,276 +359,2365 @@ bool utf8ToUnicode(const std::string_view & buffer, int & unicode, int & length)
 
 /**
  * @brief Count the number of characters in the string, which may be different 
- * to the string length if UTF-8 characters are found.
+ * to the string length if UTF-8 characters are found. Each byte that is not
+ * part of a valid UTF-8 character, including a stray continuation byte, is
+ * counted as a character, as codePoints() and charCount<Replace>() do.
  * 
  * @param buffer possibly containing UTF-8 characters.
  * @return size_t character count.
  */
 size_t charCount(const std::string_view & buffer)
 {
-    const size_t length{buffer.length()};
-    size_t count{};
+    size_t malformed{};
 
-    for (int i{}; i < length; ++i)
-    {
-        const std::string_view view{buffer.substr(i)};
-        const size_t bytes{numUtf8Bytes(view)};
+    return charCount(buffer, malformed);
+}
+
+/**
+ * @brief Count the number of characters in the string, as charCount(), and
+ * also count the bytes that are not part of a valid UTF-8 character. The
+ * valid runs between invalid bytes are counted by the count kernel, which
+ * only counts the bytes that are not continuation bytes.
+ * 
+ * @param buffer possibly containing UTF-8 characters.
+ * @param malformed returned count of bytes not part of a valid character.
+ * @return size_t character count.
+ */
+size_t charCount(const std::string_view & buffer, size_t & malformed)
+{
+    const char * p{buffer.data()};
+    const char * const end{p + buffer.length()};
 
-        if (bytes)
+    size_t count{};
+    malformed = 0;
+    for (;;)
+    {
+        const char * invalid{validateUtf8(p, end)};
+        count += countUtf8(p, invalid);
+        if (invalid == end)
+            break;
+
+        // Count one character at a time until 64 bytes pass without an
+        // invalid byte, so malformed text does not restart the kernels for
+        // every byte.
+        for (p = invalid; (p != end) && (p - invalid < 64); ++count)
         {
-            i += bytes-1;
-        }
+            const size_t len{sequenceLength(p, end)};
+            if (!len)
+            {
+                ++malformed;
+                invalid = p;
+            }
 
-        ++count;
+            p += len ? len : 1;
+        }
     }
 
-
     return count;
 }
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Unicode and/or UTF-8 to HTML.
+// Whole buffer UTF-8 validation.
 
 /**
- * @brief Replace ISO/IEC 8859-1 & UTF-8 characters in a given string with the
- * corresponding character references necessary for HTML & XML compatibility.
+ * @brief Find the first byte in the string buffer that is not part of a valid
+ * UTF-8 character. Unlike utf8ToUnicode(), overlong encodings, surrogates and
+ * values above U+10FFFF are all rejected.
  * 
- * @param buffer containing ISO/IEC 8859-1 & UTF-8 characters to be replaced.
+ * @param buffer possibly containing UTF-8 characters.
+ * @return size_t offset of the first invalid byte, or std::string_view::npos
+ *         if buffer contains only valid UTF-8.
  */
-void useCharacterRefs(std::string & buffer)
+size_t findInvalid(const std::string_view & buffer)
 {
-    // Note buffer length changes here.
-    for (size_t i{}; i < buffer.length(); i++)
-    {
-        if (buffer[i] < 32)
-        {
-            const size_t pos{i};
+    const char * begin{buffer.data()};
+    const char * end{begin + buffer.length()};
 
-            int value{};
-            int length{1};
-            if (utf8ToUnicode(buffer.substr(i), value, length))
-                i += length-1;
-            else
-                value = (unsigned char)buffer[i];
+    const char * invalid{validateUtf8(begin, end)};
+    if (invalid == end)
+        return std::string_view::npos;
 
-            std::string to{"&#" + std::to_string(value) + ";"};
-            buffer.replace(pos, length, to);
-        }
-    }
+    return invalid - begin;
 }
 
 /**
- * @brief Replace ISO/IEC 8859-1 & UTF-8 characters in a given string with the
- * corresponding character references necessary for HTML & XML compatibility.
+ * @brief Check that the string buffer contains only valid UTF-8 characters.
  * 
- * @param buffer containing ISO/IEC 8859-1 & UTF-8 characters to be replaced.
- * 
- * @return std::string with character references.
+ * @param buffer possibly containing UTF-8 characters.
+ * @return true if buffer contains only valid UTF-8, false otherwise.
  */
-std::string useCharacterRefs(const std::string & buffer)
+bool validate(const std::string_view & buffer)
 {
-    std::string work{buffer};
-    useCharacterRefs(work);
+    const char * begin{buffer.data()};
+    const char * end{begin + buffer.length()};
 
-    return work;
+    return validateUtf8(begin, end) == end;
 }
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// Change case for a UTF-8 string.
+// Bulk UTF-8 to UTF-32.
 
 /**
- * @brief Check if the given string starts with an uppercase character.
+ * @brief Decode a string of UTF-8 characters into a caller provided buffer
+ * of unicode values. Runs of ASCII and 2 byte characters are decoded in
+ * blocks where the CPU supports it.
  * 
- * @param buffer possibly starting with an ASCII or UTF-8 character.
- * @return int 1 if uppercase ASCII, 2 if 2-byte uppercase UTF-8, 0 otherwise.
+ * @param in string containing the UTF-8 characters.
+ * @param out buffer to receive the unicode values.
+ * @param cap the number of values out can hold.
+ * @return ConvertResult bytes consumed, values produced and the offset of the
+ *         first invalid character if decoding stopped there.
  */
-int isUpper(const std::string_view & buffer)
+ConvertResult decode(const std::string_view & in, char32_t * out, size_t cap)
 {
-    const unsigned char *cp((const unsigned char *)&buffer[0]);
+    const char * begin{in.data()};
+    const char * p{begin};
+    char32_t * q{out};
 
-    // Check uppercase ASCII.
-    if ((*cp > 0x40) && (*cp < 0x5B))
-        return 1;
+    ConvertResult result{};
+    if (!decodeUtf8(p, begin + in.length(), q, out + cap))
+        result.error = p - begin;
 
-    // Check not a 2-byte UTF-8 char.
-    if (*cp != 0xC3)
-        return 0;
+    result.consumed = p - begin;
+    result.produced = q - out;
 
-    // Next byte.
-    ++cp;
+    return result;
+}
 
-    // Is the symbol?
-    if (*cp == 0x97)
-        return 0;
 
-    // Check 2-byte uppercase UTF-8 char.
-    if ((*cp > 0x7F) && (*cp < 0x9F))
-        return 2;
+///////////////////////////////////////////////////////////////////////////////
+// Bulk UTF-32 to UTF-8.
 
-    return 0;
+/**
+ * @brief Determine the exact number of bytes needed to encode unicode values
+ * as UTF-8. Invalid values (surrogates and above U+10FFFF) are not counted.
+ * 
+ * @param in unicode values to encode.
+ * @return size_t the UTF-8 byte count.
+ */
+size_t encodedLength(std::span<const char32_t> in)
+{
+    return lengthScalar(in.data(), in.data() + in.size());
 }
 
 /**
- * @brief Check if the given string starts with a lowercase character.
+ * @brief Encode unicode values as UTF-8 characters into a caller provided
+ * buffer. Runs of ASCII and 2 byte characters are encoded in blocks where the
+ * CPU supports it. Characters are never split across the end of the buffer.
  * 
- * @param buffer possibly starting with an ASCII or UTF-8 character.
- * @return int 1 if lowercase ASCII, 2 if 2-byte lowercase UTF-8, 0 otherwise.
+ * @param in unicode values to encode.
+ * @param out buffer to receive the UTF-8 characters.
+ * @param cap the number of bytes out can hold.
+ * @return ConvertResult values consumed, bytes produced and the index of the
+ *         first invalid value if encoding stopped there.
  */
-int isLower(const std::string_view & buffer)
+ConvertResult encode(std::span<const char32_t> in, char * out, size_t cap)
 {
-    const unsigned char *cp((const unsigned char *)&buffer[0]);
-    // Check lowercase ASCII.
-    if ((*cp > 0x60) && (*cp < 0x7B))
-        return 1;
-
-    // Check not a 2-byte UTF-8 char.
-    if (*cp != 0xC3)
-        return 0;
-
-    // Next byte.
-    ++cp;
+    const char32_t * begin{in.data()};
+    const char32_t * p{begin};
+    char * q{out};
 
-    // Is the symbol?
-    if (*cp == 0xB7)
-        return 0;
+    ConvertResult result{};
+    if (!encodeUtf8(p, begin + in.size(), q, out + cap))
+        result.error = p - begin;
 
-    // Check 2-byte lowercase UTF-8 char.
-    if ((*cp > 0x9F) && (*cp < 0xBF))
-        return 2;
+    result.consumed = p - begin;
+    result.produced = q - out;
 
-    return 0;
+    return result;
 }
 
 /**
- * @brief Convert a lowercase character to uppercase at the start of string.
+ * @brief Run a bulk conversion into a local block, appending each block to a
+ * sink, so that the output is never allocated.
  * 
- * @param buffer possibly starting with an ASCII or UTF-8 lowercase character.
- * @return int 1 if uppercase ASCII, 2 if 2-byte uppercase UTF-8, 0 otherwise.
+ * @param size the number of input elements.
+ * @param sink to append the output to.
+ * @param convert callable converting the input from an offset into a buffer.
+ * @return ConvertResult elements consumed, bytes produced and the offset of
+ *         the first invalid input if conversion stopped there.
  */
-int toUpper(std::string & buffer)
+template<typename F>
+ConvertResult convertToSink(size_t size, SinkRef sink, F convert)
 {
-    const int lower{isLower(buffer)};
-    if (lower == 0)
+    char block[4096];
+
+    ConvertResult total{};
+    while (total.consumed < size)
     {
-        return 0;
-    }
+        const ConvertResult result{convert(total.consumed, block, sizeof(block))};
+        sink.append(block, result.produced);
+        total.produced += result.produced;
 
-    unsigned char *cp((unsigned char *)buffer.c_str());
+        if (result.error != std::string_view::npos)
+            total.error = total.consumed + result.error;
 
-    // Move to next byte for UTF-8.
-    if (lower == 2)
-    {
-        ++cp;
+        total.consumed += result.consumed;
+        if ((result.error != std::string_view::npos) || (result.consumed == 0))
+            break;
     }
 
-    // Flip case.
-    *cp ^= 0x20;
+    return total;
+}
 
-    return lower;
+/**
+ * @brief Encode unicode values as UTF-8 characters to a sink, a block at a
+ * time. Encoding stops at the first invalid value.
+ * 
+ * @param in unicode values to encode.
+ * @param sink to append the UTF-8 characters to.
+ * @return ConvertResult values consumed, bytes produced and the index of the
+ *         first invalid value if encoding stopped there.
+ */
+ConvertResult encode(std::span<const char32_t> in, SinkRef sink)
+{
+    return convertToSink(in.size(), sink,
+        [&](size_t offset, char * out, size_t cap) { return encode(in.subspan(offset), out, cap); });
 }
 
+
+///////////////////////////////////////////////////////////////////////////////
+// Bulk UTF-8 to and from UTF-16.
+
 /**
- * @brief Convert a uppercase character to lowercase at the start of string.
+ * @brief Count the 4 byte lead bytes (11110___) 8 bytes at a time.
  * 
- * @param buffer possibly starting with an ASCII or UTF-8  uppercase character.
- * @return int 1 if lowercase ASCII, 2 if 2-byte lowercase UTF-8, 0 otherwise.
+ * @param begin of the buffer to count.
+ * @param end of the buffer to count.
+ * @return size_t the number of lead bytes of 0xF0 and above.
  */
-int toLower(std::string & buffer)
+size_t countQuadLeads(const char * begin, const char * end)
 {
-    const int upper{isUpper(buffer)};
-    if (upper == 0)
+    constexpr uint64_t high{0x8080808080808080};
+
+    size_t count{};
+    const char * p{begin};
+    for (; end - p >= 8; p += 8)
     {
-        return 0;
+        uint64_t word{};
+        std::memcpy(&word, p, 8);
+
+        // The top bit of each byte is set if its top 4 bits are all set.
+        count += std::popcount(word & (word << 1) & (word << 2) & (word << 3) & high);
     }
 
-    unsigned char *cp((unsigned char *)buffer.c_str());
+    for (; p != end; ++p)
+        count += ((unsigned char)*p >= 0xF0);
+
+    return count;
+}
+
+/**
+ * @brief Determine the exact number of UTF-16 code units needed to decode a
+ * string of valid UTF-8 characters. Each character needs one unit, except
+ * for 4 byte characters, which need a surrogate pair.
+ * 
+ * @param in string containing the UTF-8 characters.
+ * @return size_t the UTF-16 code unit count.
+ */
+size_t utf16Length(const std::string_view & in)
+{
+    const char * begin{in.data()};
+    const char * end{begin + in.length()};
+
+    return countUtf8(begin, end) + countQuadLeads(begin, end);
+}
+
+/**
+ * @brief Decode a string of UTF-8 characters into a caller provided buffer
+ * of UTF-16 code units. Characters above U+FFFF become surrogate pairs, which
+ * are never split across the end of the buffer. Runs of ASCII and 2 byte
+ * characters are decoded in blocks where the CPU supports it.
+ * 
+ * @param in string containing the UTF-8 characters.
+ * @param out buffer to receive the UTF-16 code units.
+ * @param cap the number of code units out can hold.
+ * @return ConvertResult bytes consumed, units produced and the offset of the
+ *         first invalid character if decoding stopped there.
+ */
+ConvertResult decode(const std::string_view & in, char16_t * out, size_t cap)
+{
+    const char * begin{in.data()};
+    const char * p{begin};
+    char16_t * q{out};
+
+    ConvertResult result{};
+    if (!decode16Utf8(p, begin + in.length(), q, out + cap))
+        result.error = p - begin;
+
+    result.consumed = p - begin;
+    result.produced = q - out;
+
+    return result;
+}
+
+/**
+ * @brief Determine the exact number of bytes needed to encode UTF-16 as
+ * UTF-8. Unpaired surrogates are not counted.
+ * 
+ * @param in UTF-16 code units to encode.
+ * @return size_t the UTF-8 byte count.
+ */
+size_t encodedLength(std::span<const char16_t> in)
+{
+    return length16Scalar(in.data(), in.data() + in.size());
+}
+
+/**
+ * @brief Encode UTF-16 code units as UTF-8 characters into a caller provided
+ * buffer. Surrogate pairs are combined, an unpaired surrogate is invalid. Runs
+ * of ASCII and 2 byte characters are encoded in blocks where the CPU supports
+ * it. Characters are never split across the end of the buffer.
+ * 
+ * @param in UTF-16 code units to encode.
+ * @param out buffer to receive the UTF-8 characters.
+ * @param cap the number of bytes out can hold.
+ * @return ConvertResult units consumed, bytes produced and the index of the
+ *         first invalid unit if encoding stopped there.
+ */
+ConvertResult encode(std::span<const char16_t> in, char * out, size_t cap)
+{
+    const char16_t * begin{in.data()};
+    const char16_t * p{begin};
+    char * q{out};
+
+    ConvertResult result{};
+    if (!encode16Utf8(p, begin + in.size(), q, out + cap))
+        result.error = p - begin;
+
+    result.consumed = p - begin;
+    result.produced = q - out;
+
+    return result;
+}
+
+/**
+ * @brief Encode UTF-16 code units as UTF-8 characters to a sink, a block at a
+ * time. Encoding stops at the first invalid unit.
+ * 
+ * @param in UTF-16 code units to encode.
+ * @param sink to append the UTF-8 characters to.
+ * @return ConvertResult units consumed, bytes produced and the index of the
+ *         first invalid unit if encoding stopped there.
+ */
+ConvertResult encode(std::span<const char16_t> in, SinkRef sink)
+{
+    return convertToSink(in.size(), sink,
+        [&](size_t offset, char * out, size_t cap) { return encode(in.subspan(offset), out, cap); });
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ISO/IEC 8859-1 to and from UTF-8.
+
+/**
+ * @brief Count the bytes with the top bit set 8 bytes at a time.
+ * 
+ * @param begin of the buffer to count.
+ * @param end of the buffer to count.
+ * @return size_t the number of bytes of 0x80 and above.
+ */
+size_t countHighBytes(const char * begin, const char * end)
+{
+    constexpr uint64_t high{0x8080808080808080};
 
-    // Move to next byte for UTF-8.
-    if (upper == 2)
+    size_t count{};
+    const char * p{begin};
+    for (; end - p >= 8; p += 8)
     {
-        ++cp;
+        uint64_t word{};
+        std::memcpy(&word, p, 8);
+        count += std::popcount(word & high);
     }
 
-    // Flip case.
-    *cp ^= 0x20;
+    for (; p != end; ++p)
+        count += ((unsigned char)*p >= 0x80);
 
-    return upper;
+    return count;
 }
 
 /**
- * @brief Convert lowercase characters to uppercase in the given string.
+ * @brief Determine the exact number of bytes needed to convert ISO/IEC 8859-1
+ * to UTF-8, which is one more for every byte that is not ASCII.
  * 
- * @param buffer possibly containing ASCII or UTF-8 lowercase characters.
+ * @param in string containing ISO/IEC 8859-1 characters.
+ * @return size_t the UTF-8 byte count.
  */
-void makeUpper(std::string & buffer)
+size_t latin1ToUtf8Length(const std::string_view & in)
 {
-    const std::string_view view{buffer};
+    const char * begin{in.data()};
 
-    const auto length{buffer.length()};
-    for (size_t i{}; i < length; i++)
-    {
-        auto lead{view.substr(i)};
-        const int lower{isLower(lead)};
-        
-        if (lower == 0)
-        {
-            // Skip over any UTF-8 bytes.
-            const size_t bytes{numUtf8Bytes(lead)};
-            if (bytes)
-            {
-                i += bytes-1;
-            }
-            continue;
-        }
+    return in.length() + countHighBytes(begin, begin + in.length());
+}
 
-        // Skip to next byte for UTF-8.
-        if (lower == 2)
-        {
-            ++i;
-        }
+/**
+ * @brief Convert ISO/IEC 8859-1 characters to UTF-8 into a caller provided
+ * buffer. Runs of ASCII are copied in blocks of up to 32 bytes where the CPU
+ * supports it. Every byte is a valid character, so there is no error.
+ * 
+ * @param in string containing ISO/IEC 8859-1 characters.
+ * @param out buffer to receive the UTF-8 characters.
+ * @param cap the number of bytes out can hold.
+ * @return ConvertResult bytes consumed and bytes produced.
+ */
+ConvertResult latin1ToUtf8(const std::string_view & in, char * out, size_t cap)
+{
+    const char * begin{in.data()};
+    const char * p{begin};
+    char * q{out};
 
-        // Flip case.
-        buffer[i] ^= 0x20;
-    }
+    fromLatin1(p, begin + in.length(), q, out + cap);
+
+    ConvertResult result{};
+    result.consumed = p - begin;
+    result.produced = q - out;
+
+    return result;
 }
 
 /**
- * @brief Convert uppercase characters to lowercase in the given string.
+ * @brief Generate the UTF-8 version of ISO/IEC 8859-1 characters, allocating
+ * the exact size once.
  * 
- * @param buffer possibly containing ASCII or UTF-8 uppercase characters.
+ * @param in string containing ISO/IEC 8859-1 characters.
+ * @return std::string the UTF-8 string.
  */
-void makeLower(std::string & buffer)
+std::string latin1ToUtf8(const std::string_view & in)
 {
-    const std::string_view view{buffer};
+    std::string output(latin1ToUtf8Length(in), '\0');
+    latin1ToUtf8(in, output.data(), output.length());
 
-    const auto length{buffer.length()};
-    for (size_t i{}; i < length; i++)
-    {
-        auto lead{view.substr(i)};
-        const int upper{isUpper(lead)};
-        
-        if (upper == 0)
-        {
-            // Skip over any UTF-8 bytes.
-            auto bytes{numUtf8Bytes(lead)};
-            if (bytes)
-            {
-                i += bytes-1;
-            }
-            continue;
-        }
+    return output;
+}
 
-        // Skip to next byte for UTF-8.
-        if (upper == 2)
-        {
-            ++i;
-        }
+/**
+ * @brief Convert ISO/IEC 8859-1 characters to UTF-8 to a sink, a block at a
+ * time.
+ * 
+ * @param in string containing ISO/IEC 8859-1 characters.
+ * @param sink to append the UTF-8 characters to.
+ */
+void latin1ToUtf8(const std::string_view & in, SinkRef sink)
+{
+    convertToSink(in.length(), sink,
+        [&](size_t offset, char * out, size_t cap) { return latin1ToUtf8(in.substr(offset), out, cap); });
+}
+
+/**
+ * @brief Convert UTF-8 to ISO/IEC 8859-1 into a caller provided buffer,
+ * without loss. Conversion stops at the first character that is invalid or
+ * above U+00FF. The output is never longer than the input. Runs of ASCII are
+ * copied in blocks of up to 32 bytes where the CPU supports it.
+ * 
+ * @param in string containing the UTF-8 characters.
+ * @param out buffer to receive the ISO/IEC 8859-1 characters.
+ * @param cap the number of bytes out can hold.
+ * @return ConvertResult bytes consumed, bytes produced and the offset of the
+ *         first character that could not be converted.
+ */
+ConvertResult utf8ToLatin1(const std::string_view & in, char * out, size_t cap)
+{
+    const char * begin{in.data()};
+    const char * p{begin};
+    char * q{out};
+
+    ConvertResult result{};
+    if (!toLatin1(p, begin + in.length(), q, out + cap))
+        result.error = p - begin;
+
+    result.consumed = p - begin;
+    result.produced = q - out;
+
+    return result;
+}
+
+/**
+ * @brief Convert UTF-8 to ISO/IEC 8859-1 into a caller provided buffer,
+ * writing substitute for each character above U+00FF and for each invalid
+ * byte. The output is never longer than the input.
+ * 
+ * @param in string containing the UTF-8 characters.
+ * @param out buffer to receive the ISO/IEC 8859-1 characters.
+ * @param cap the number of bytes out can hold.
+ * @param substitute character for those that cannot be converted.
+ * @return ConvertResult bytes consumed, bytes produced and the offset of the
+ *         first character that was substituted, if any.
+ */
+ConvertResult utf8ToLatin1(const std::string_view & in, char * out, size_t cap, char substitute)
+{
+    const char * const begin{in.data()};
+    const char * const end{begin + in.length()};
+    char * const last{out + cap};
+    const char * p{begin};
+    char * q{out};
+
+    ConvertResult result{};
+    while (!toLatin1(p, end, q, last) && (q != last))
+    {
+        if (result.error == std::string_view::npos)
+            result.error = p - begin;
 
-        // Flip case.
-        buffer[i] ^= 0x20;
+        // Replace a whole character, or a single invalid byte.
+        const size_t len{sequenceLength(p, end)};
+        p += len ? len : 1;
+        *q++ = substitute;
     }
+
+    result.consumed = p - begin;
+    result.produced = q - out;
+
+    return result;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Bulk decoding with an error handling policy.
+
+/*
+ * The kernels stop at each invalid byte, where the policy is applied before
+ * continuing from the next byte. The policy is a template argument, so the
+ * choice is made at compile time and the kernels are unchanged. The error
+ * offset reports the first invalid byte whatever the policy.
+ */
+
+/**
+ * @brief Determine the unicode value an invalid byte is replaced by.
+ * 
+ * @param byte the invalid byte.
+ * @return char32_t the replacement value for the policy.
+ */
+template<typename Policy>
+constexpr char32_t replacement(char byte)
+{
+    if constexpr (std::is_same_v<Policy, Latin1>)
+        return (unsigned char)byte;
+    else
+        return replacementCharacter;
+}
+
+/**
+ * @brief Count the unicode values that decode() will produce from a string
+ * with the given error handling policy, so the output can be allocated once.
+ * 
+ * @param buffer possibly containing UTF-8 characters.
+ * @return size_t the number of unicode values.
+ */
+template<typename Policy>
+size_t charCount(const std::string_view & buffer)
+{
+    const char * p{buffer.data()};
+    const char * const end{p + buffer.length()};
+
+    size_t count{};
+    for (;;)
+    {
+        const char * invalid{validateUtf8(p, end)};
+        count += countUtf8(p, invalid);
+        if constexpr (std::is_same_v<Policy, Strict>)
+            break;
+
+        if (invalid == end)
+            break;
+
+        if constexpr (!std::is_same_v<Policy, Skip>)
+            ++count;
+
+        p = invalid + 1;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Decode a string of UTF-8 characters into a caller provided buffer
+ * of unicode values, handling invalid bytes with the given policy.
+ * 
+ * @param in string containing the UTF-8 characters.
+ * @param out buffer to receive the unicode values.
+ * @param cap the number of values out can hold.
+ * @return ConvertResult bytes consumed, values produced and the offset of the
+ *         first invalid byte, if any.
+ */
+template<typename Policy>
+ConvertResult decode(const std::string_view & in, char32_t * out, size_t cap)
+{
+    const char * const begin{in.data()};
+    const char * const end{begin + in.length()};
+    char32_t * const last{out + cap};
+    const char * p{begin};
+    char32_t * q{out};
+
+    ConvertResult result{};
+    while (!decodeUtf8(p, end, q, last))
+    {
+        if constexpr (!std::is_same_v<Policy, Strict> && !std::is_same_v<Policy, Skip>)
+        {
+            if (q == last)
+                break;
+
+            *q++ = replacement<Policy>(*p);
+        }
+
+        if (result.error == std::string_view::npos)
+            result.error = p - begin;
+
+        if constexpr (std::is_same_v<Policy, Strict>)
+            break;
+
+        ++p;
+    }
+
+    result.consumed = p - begin;
+    result.produced = q - out;
+
+    return result;
+}
+
+/**
+ * @brief Decode a string of UTF-8 characters into a caller provided buffer
+ * of UTF-16 code units, handling invalid bytes with the given policy.
+ * 
+ * @param in string containing the UTF-8 characters.
+ * @param out buffer to receive the UTF-16 code units.
+ * @param cap the number of code units out can hold.
+ * @return ConvertResult bytes consumed, units produced and the offset of the
+ *         first invalid byte, if any.
+ */
+template<typename Policy>
+ConvertResult decode(const std::string_view & in, char16_t * out, size_t cap)
+{
+    const char * const begin{in.data()};
+    const char * const end{begin + in.length()};
+    char16_t * const last{out + cap};
+    const char * p{begin};
+    char16_t * q{out};
+
+    ConvertResult result{};
+    while (!decode16Utf8(p, end, q, last))
+    {
+        if constexpr (!std::is_same_v<Policy, Strict> && !std::is_same_v<Policy, Skip>)
+        {
+            if (q == last)
+                break;
+
+            *q++ = (char16_t)replacement<Policy>(*p);
+        }
+
+        if (result.error == std::string_view::npos)
+            result.error = p - begin;
+
+        if constexpr (std::is_same_v<Policy, Strict>)
+            break;
+
+        ++p;
+    }
+
+    result.consumed = p - begin;
+    result.produced = q - out;
+
+    return result;
+}
+
+/**
+ * @brief Make the string buffer valid UTF-8 in place, handling invalid bytes
+ * with the given policy, which may not be Strict. A valid buffer is only
+ * validated and is otherwise untouched, an invalid buffer is only rewritten
+ * from the first invalid byte onwards. Skip compacts the buffer in place,
+ * Replace and Latin1 grow it, so the rewritten part is built separately and
+ * appended.
+ * 
+ * @param buffer possibly containing invalid UTF-8.
+ * @return size_t the number of invalid bytes found, 0 if buffer was valid.
+ */
+template<typename Policy>
+size_t sanitize(std::string & buffer)
+{
+    static_assert(!std::is_same_v<Policy, Strict>, "sanitize() needs a policy that repairs invalid bytes");
+
+    const char * const begin{buffer.data()};
+    const char * const end{begin + buffer.length()};
+    const char * p{validateUtf8(begin, end)};
+    if (p == end)
+        return 0;
+
+    size_t invalid{};
+    if constexpr (std::is_same_v<Policy, Skip>)
+    {
+        char * out{buffer.data() + (p - begin)};
+        while (p != end)
+        {
+            ++invalid;
+            const char * next{validateUtf8(++p, end)};
+            out = std::copy(p, next, out);
+            p = next;
+        }
+
+        buffer.resize(out - begin);
+    }
+    else
+    {
+        const size_t first{(size_t)(p - begin)};
+        std::string tail{};
+        tail.reserve(end - p + 8);
+        while (p != end)
+        {
+            ++invalid;
+            char bytes[4];
+            tail.append(bytes, encode(replacement<Policy>(*p), bytes));
+
+            const char * next{validateUtf8(++p, end)};
+            tail.append(p, next);
+            p = next;
+        }
+
+        buffer.resize(first);
+        buffer.append(tail);
+    }
+
+    return invalid;
+}
+
+template size_t sanitize<Replace>(std::string & buffer);
+template size_t sanitize<Skip>(std::string & buffer);
+template size_t sanitize<Latin1>(std::string & buffer);
+
+template size_t charCount<Strict>(const std::string_view & buffer);
+template size_t charCount<Replace>(const std::string_view & buffer);
+template size_t charCount<Skip>(const std::string_view & buffer);
+template size_t charCount<Latin1>(const std::string_view & buffer);
+
+template ConvertResult decode<Strict>(const std::string_view & in, char32_t * out, size_t cap);
+template ConvertResult decode<Replace>(const std::string_view & in, char32_t * out, size_t cap);
+template ConvertResult decode<Skip>(const std::string_view & in, char32_t * out, size_t cap);
+template ConvertResult decode<Latin1>(const std::string_view & in, char32_t * out, size_t cap);
+
+template ConvertResult decode<Strict>(const std::string_view & in, char16_t * out, size_t cap);
+template ConvertResult decode<Replace>(const std::string_view & in, char16_t * out, size_t cap);
+template ConvertResult decode<Skip>(const std::string_view & in, char16_t * out, size_t cap);
+template ConvertResult decode<Latin1>(const std::string_view & in, char16_t * out, size_t cap);
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Streaming UTF-8 to UTF-32.
+
+/**
+ * @brief Check if the bytes at p could be the start of a valid UTF-8
+ * character that continues beyond end.
+ * 
+ * @param p points to the first byte of the character.
+ * @param end points past the last byte available.
+ * @return true if p to end is the incomplete start of a valid character.
+ */
+bool isIncomplete(const unsigned char * p, const unsigned char * end)
+{
+    const size_t available{(size_t)(end - p)};
+    if (available > 3)
+        return false;
+
+    // Complete the character with the lowest, then the highest continuation
+    // byte, as every valid range of second bytes includes one or the other.
+    unsigned char work[4]{};
+    std::copy(p, end, work);
+    for (unsigned char fill : { 0x80, 0xBF })
+    {
+        std::fill(work + available, work + 4, fill);
+        if (sequenceLength(work, work + 4) > available)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Validate the next chunk of input. Bytes of a character that
+ * continues into the next chunk are held until then. Decoding stops at the
+ * first invalid byte and the held bytes are discarded.
+ * 
+ * @param chunk the next part of the input.
+ * @return Spans the validated characters and the offset of the first invalid
+ *         byte in chunk, which is 0 if the held bytes could not be completed.
+ */
+StreamDecoder::Spans StreamDecoder::feed(const std::string_view & chunk)
+{
+    Spans spans{};
+    std::string_view rest{chunk};
+
+    // Complete any character held from earlier chunks.
+    if (held)
+    {
+        const unsigned char * lead{(const unsigned char *)bytes};
+        const size_t needed{held + std::min<size_t>(chunk.length(), 4 - held)};
+        std::copy(chunk.data(), chunk.data() + (needed - held), bytes + held);
+
+        const size_t len{sequenceLength(lead, lead + needed)};
+        if (len)
+        {
+            std::copy(bytes, bytes + len, head);
+            spans.head = std::string_view{head, len};
+            rest.remove_prefix(len - held);
+            held = 0;
+        }
+        else
+        if (isIncomplete(lead, lead + needed))
+        {
+            held = needed;
+
+            return spans;
+        }
+        else
+        {
+            held = 0;
+            spans.error = 0;
+
+            return spans;
+        }
+    }
+
+    const char * begin{rest.data()};
+    const char * end{begin + rest.length()};
+    const char * invalid{validateUtf8(begin, end)};
+    spans.body = std::string_view{begin, (size_t)(invalid - begin)};
+
+    if (invalid == end)
+        return spans;
+
+    // Hold the start of a character split by the end of the chunk.
+    if (isIncomplete((const unsigned char *)invalid, (const unsigned char *)end))
+    {
+        held = end - invalid;
+        std::copy(invalid, end, bytes);
+    }
+    else
+        spans.error = invalid - chunk.data();
+
+    return spans;
+}
+
+/**
+ * @brief Mark the end of the input and reset the decoder.
+ * 
+ * @return true if no incomplete character was held, false otherwise.
+ */
+bool StreamDecoder::finish(void)
+{
+    const bool complete{held == 0};
+    held = 0;
+
+    return complete;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Truncation on character boundaries.
+
+/**
+ * @brief Get the longest prefix of the string buffer that fits in maxBytes
+ * without splitting a valid UTF-8 character. Only the bytes around the cut
+ * are examined, so the cost does not depend on the length of the buffer.
+ * 
+ * @param buffer possibly containing UTF-8 characters.
+ * @param maxBytes the maximum length of the result in bytes.
+ * @return std::string_view the truncated buffer.
+ */
+std::string_view truncateToBytes(const std::string_view & buffer, size_t maxBytes)
+{
+    if (buffer.length() <= maxBytes)
+        return buffer;
+
+    // Cutting before a character start never splits a character.
+    if ((maxBytes == 0) || (((unsigned char)buffer[maxBytes] & 0xC0) != 0x80))
+        return buffer.substr(0, maxBytes);
+
+    // Find the character containing the cut, if it is valid.
+    size_t lead{maxBytes - 1};
+    for (int i{}; (i < 2) && (lead > 0) && (((unsigned char)buffer[lead] & 0xC0) == 0x80); ++i)
+        --lead;
+
+    const char * begin{buffer.data()};
+    const size_t len{sequenceLength(begin + lead, begin + buffer.length())};
+
+    return buffer.substr(0, (lead + len > maxBytes) ? lead : maxBytes);
+}
+
+/**
+ * @brief Get the prefix of the string buffer holding the first count
+ * characters, counting each invalid byte as a character, as codePoints().
+ * Only the prefix is scanned.
+ * 
+ * @param buffer possibly containing UTF-8 characters.
+ * @param count the maximum number of characters in the result.
+ * @return std::string_view the truncated buffer.
+ */
+std::string_view truncateToChars(const std::string_view & buffer, size_t count)
+{
+    // Every character is at least one byte.
+    if (buffer.length() <= count)
+        return buffer;
+
+    const char * begin{buffer.data()};
+    const char * end{begin + buffer.length()};
+    const char * p{begin};
+    for (; (count != 0) && (p != end); --count)
+    {
+        const size_t len{sequenceLength(p, end)};
+        p += len ? len : 1;
+    }
+
+    return buffer.substr(0, p - begin);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Indexed UTF-8 string.
+
+/**
+ * @brief Check if the next 8 bytes are all ASCII.
+ * 
+ * @param p points to the first of at least 8 bytes.
+ * @return true if all 8 bytes are ASCII, false otherwise.
+ */
+inline bool isAscii8(const char * p)
+{
+    uint64_t word{};
+    std::memcpy(&word, p, 8);
+
+    return (word & 0x8080808080808080) == 0;
+}
+
+/**
+ * @brief Step over count characters, as codePoints().
+ * 
+ * @param p points to the first character.
+ * @param end points past the last byte available.
+ * @param count of characters to step over, which must all be before end.
+ * @return const char * the start of the character after them.
+ */
+const char * skipChars(const char * p, const char * end, size_t count)
+{
+    for (; count >= 8 && (end - p >= 8) && isAscii8(p); count -= 8)
+        p += 8;
+
+    for (; count; --count)
+    {
+        const size_t len{sequenceLength(p, end)};
+        p += len ? len : 1;
+    }
+
+    return p;
+}
+
+/**
+ * @brief Extend the index to cover the whole string, continuing from where
+ * it was left.
+ */
+void IndexedString::buildIndex(void) const
+{
+    const char * begin{text.data()};
+    const char * end{begin + text.length()};
+    const char * p{begin + indexed};
+
+    while (p != end)
+    {
+        if (count % interval == 0)
+            checkpoints.push_back(p - begin);
+
+        // Step over whole intervals of ASCII at once.
+        if ((count % interval == 0) && (end - p >= (ptrdiff_t)interval))
+        {
+            bool ascii{true};
+            for (size_t i{}; ascii && (i < interval); i += 8)
+                ascii = isAscii8(p + i);
+
+            if (ascii)
+            {
+                p += interval;
+                count += interval;
+                continue;
+            }
+        }
+
+        const size_t len{sequenceLength(p, end)};
+        p += len ? len : 1;
+        ++count;
+    }
+
+    indexed = text.length();
+}
+
+/**
+ * @brief Append to the string. Characters within 3 bytes of the old end may
+ * be completed by the appended bytes, so the index is cut back to the last
+ * checkpoint before them and is extended from there on next use.
+ * 
+ * @param buffer possibly containing UTF-8 characters.
+ */
+void IndexedString::append(const std::string_view & buffer)
+{
+    const size_t safe{(text.length() > 3) ? text.length() - 3 : 0};
+    text.append(buffer);
+
+    if (indexed <= safe)
+        return;
+
+    while (!checkpoints.empty() && (checkpoints.back() >= safe))
+        checkpoints.pop_back();
+
+    indexed = checkpoints.empty() ? 0 : checkpoints.back();
+    count = checkpoints.empty() ? 0 : (checkpoints.size() - 1) * interval;
+    if (!checkpoints.empty())
+        checkpoints.pop_back();
+}
+
+/**
+ * @brief Get the number of characters in the string.
+ * 
+ * @return size_t character count.
+ */
+size_t IndexedString::length(void) const
+{
+    buildIndex();
+
+    return count;
+}
+
+/**
+ * @brief Get the byte offset of a character.
+ * 
+ * @param index of the character.
+ * @return size_t byte offset of the character, size() if index is the
+ *         character count, or std::string::npos if index is beyond that.
+ */
+size_t IndexedString::byteOffset(size_t index) const
+{
+    buildIndex();
+
+    if (index >= count)
+        return (index == count) ? text.length() : std::string::npos;
+
+    const char * begin{text.data()};
+    const char * p{begin + checkpoints[index / interval]};
+
+    return skipChars(p, begin + text.length(), index % interval) - begin;
+}
+
+/**
+ * @brief Get the index of the character containing a byte.
+ * 
+ * @param offset of the byte.
+ * @return size_t index of the character, or the character count if offset
+ *         is at or beyond the end.
+ */
+size_t IndexedString::charIndex(size_t offset) const
+{
+    buildIndex();
+
+    if (offset >= text.length())
+        return count;
+
+    const auto checkpoint{std::upper_bound(checkpoints.begin(), checkpoints.end(), offset) - 1};
+    size_t index{(checkpoint - checkpoints.begin()) * interval};
+
+    const char * begin{text.data()};
+    const char * end{begin + text.length()};
+    const char * target{begin + offset};
+    for (const char * p{begin + *checkpoint}; ; ++index)
+    {
+        const size_t len{sequenceLength(p, end)};
+        p += len ? len : 1;
+        if (p > target)
+            break;
+    }
+
+    return index;
+}
+
+/**
+ * @brief Get the unicode value of a character.
+ * 
+ * @param index of the character, which must be less than length().
+ * @return char32_t the unicode value, or U+FFFD if the byte is invalid.
+ */
+char32_t IndexedString::at(size_t index) const
+{
+    const char * begin{text.data()};
+    const char * p{begin + byteOffset(index)};
+    const size_t len{sequenceLength(p, begin + text.length())};
+
+    return len ? decodeSequence(p, len) : replacementCharacter;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Unicode and/or UTF-8 to HTML.
+
+/**
+ * @brief Find the next byte in the string buffer that needs to be replaced by
+ * a character reference, which is any control character, ISO/IEC 8859-1 or
+ * UTF-8 byte.
+ * 
+ * @param buffer being converted.
+ * @param pos offset to start searching from.
+ * @return size_t offset of the next byte needing a reference, or the length.
+ */
+inline size_t nextReference(const std::string_view & buffer, size_t pos)
+{
+    const char * begin{buffer.data()};
+
+    return findReference(begin + pos, begin + buffer.length()) - begin;
+}
+
+/**
+ * @brief Get the value of the character reference for the character at the
+ * start of the string buffer. Invalid UTF-8 bytes are treated as ISO/IEC
+ * 8859-1 characters.
+ * 
+ * @param buffer starting with the character to be replaced.
+ * @param value returned value of the character reference.
+ * @return size_t number of bytes of buffer replaced by the reference.
+ */
+size_t getReference(const std::string_view & buffer, int & value)
+{
+    int length{1};
+    if (!utf8ToUnicode(buffer, value, length))
+        value = (unsigned char)buffer[0];
+
+    return length;
+}
+
+/**
+ * @brief Determine the number of characters needed to display value as a
+ * decimal character reference.
+ * 
+ * @param value of the character reference.
+ * @return size_t length of "&#value;".
+ */
+size_t referenceLength(int value)
+{
+    size_t digits{1};
+    for (; value >= 10; value /= 10)
+        ++digits;
+
+    return digits + 3;
+}
+
+/**
+ * @brief Determine the length of the string that would be generated by
+ * replacing ISO/IEC 8859-1 & UTF-8 characters in a given string with the
+ * corresponding character references.
+ * 
+ * @param buffer containing ISO/IEC 8859-1 & UTF-8 characters to be replaced.
+ * @return size_t length of the string with character references.
+ */
+size_t characterRefsLength(const std::string_view & buffer)
+{
+    const size_t length{buffer.length()};
+    size_t size{};
+
+    for (size_t i{}; i < length; )
+    {
+        // Count the run of characters that do not need replacing.
+        const size_t start{i};
+        i = nextReference(buffer, i);
+        size += i - start;
+        if (i == length)
+            break;
+
+        int value{};
+        i += getReference(buffer.substr(i), value);
+        size += referenceLength(value);
+    }
+
+    return size;
+}
+
+/**
+ * @brief Write a given string to a sink, replacing ISO/IEC 8859-1 & UTF-8
+ * characters with the corresponding character references necessary for HTML &
+ * XML compatibility. Runs of characters not needing replacement are appended
+ * as a block.
+ * 
+ * @param buffer containing ISO/IEC 8859-1 & UTF-8 characters to be replaced.
+ * @param sink to append the string with character references to.
+ */
+template<Sink S>
+void characterRefsTo(const std::string_view & buffer, S & sink)
+{
+    const size_t length{buffer.length()};
+
+    for (size_t i{}; i < length; )
+    {
+        // Append the run of characters that do not need replacing.
+        const size_t start{i};
+        i = nextReference(buffer, i);
+
+        sink.append(buffer.data() + start, i - start);
+        if (i == length)
+            break;
+
+        int value{};
+        i += getReference(buffer.substr(i), value);
+
+        char work[12]{ '&', '#' };
+        char * last{std::to_chars(work + 2, work + 11, value).ptr};
+        *last++ = ';';
+        sink.append(work, last - work);
+    }
+}
+
+/**
+ * @brief Write a given string to output, replacing ISO/IEC 8859-1 & UTF-8
+ * characters with the corresponding character references necessary for HTML &
+ * XML compatibility. Runs of characters not needing replacement are copied as
+ * a block.
+ * 
+ * @param buffer containing ISO/IEC 8859-1 & UTF-8 characters to be replaced.
+ * @param output must have room for characterRefsLength(buffer) characters.
+ * @return char * pointing past the last character written.
+ */
+char * writeCharacterRefs(const std::string_view & buffer, char * output)
+{
+    PointerSink sink{output};
+    characterRefsTo(buffer, sink);
+
+    return sink.output;
+}
+
+/**
+ * @brief Write a given string to a sink, replacing ISO/IEC 8859-1 & UTF-8
+ * characters with the corresponding character references necessary for HTML &
+ * XML compatibility.
+ * 
+ * @param buffer containing ISO/IEC 8859-1 & UTF-8 characters to be replaced.
+ * @param sink to append the string with character references to.
+ */
+void writeCharacterRefs(const std::string_view & buffer, SinkRef sink)
+{
+    characterRefsTo(buffer, sink);
+}
+
+/**
+ * @brief Replace ISO/IEC 8859-1 & UTF-8 characters in a given string with the
+ * corresponding character references necessary for HTML & XML compatibility.
+ * 
+ * @param buffer containing ISO/IEC 8859-1 & UTF-8 characters to be replaced.
+ */
+void useCharacterRefs(std::string & buffer)
+{
+    // Every reference is longer than the bytes it replaces, so an unchanged
+    // length means there is nothing to replace.
+    const size_t size{characterRefsLength(buffer)};
+    if (size == buffer.length())
+        return;
+
+    std::string work(size, '\0');
+    writeCharacterRefs(buffer, work.data());
+    buffer.swap(work);
+}
+
+/**
+ * @brief Replace ISO/IEC 8859-1 & UTF-8 characters in a given string with the
+ * corresponding character references necessary for HTML & XML compatibility.
+ * 
+ * @param buffer containing ISO/IEC 8859-1 & UTF-8 characters to be replaced.
+ * 
+ * @return std::string with character references.
+ */
+std::string useCharacterRefs(const std::string & buffer)
+{
+    std::string work(characterRefsLength(buffer), '\0');
+    writeCharacterRefs(buffer, work.data());
+
+    return work;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// HTML & XML escaping.
+
+/**
+ * @brief The characters that an escaping mode replaces, besides control
+ * characters and, if requested, characters that are not ASCII.
+ */
+struct EscapeTable
+{
+    char specials[escapeSpecials];  // ASCII characters the scan stops at.
+    std::string_view names[128];    // Named reference, or empty for numeric.
+};
+
+/**
+ * @brief Build the escaping table for a mode. All modes replace '&', '<' and
+ * '>', the attribute and XML modes also replace both quotes. Only XML has a
+ * name for the apostrophe, HTML uses a numeric reference.
+ * 
+ * @param mode the escaping mode.
+ * @return EscapeTable the table for the mode.
+ */
+constexpr EscapeTable makeEscapeTable(EscapeMode mode)
+{
+    EscapeTable table{ { '&', '<', '>', '&', '&' }, {} };
+    table.names['&'] = "&amp;";
+    table.names['<'] = "&lt;";
+    table.names['>'] = "&gt;";
+
+    if (mode != EscapeMode::htmlText)
+    {
+        table.specials[3] = '"';
+        table.specials[4] = '\'';
+        table.names['"'] = "&quot;";
+    }
+
+    if (mode == EscapeMode::xml)
+        table.names['\''] = "&apos;";
+
+    return table;
+}
+
+constexpr EscapeTable escapeTables[]{
+    makeEscapeTable(EscapeMode::htmlText),
+    makeEscapeTable(EscapeMode::htmlAttribute),
+    makeEscapeTable(EscapeMode::xml),
+};
+
+/**
+ * @brief Find the HTML 4.01 named entity for a unicode value.
+ * 
+ * @param unicode value to find the name of.
+ * @return const Entity * the entity, or nullptr if the value has no name.
+ */
+const Entity * findEntity(char32_t unicode)
+{
+    const Entity * entity{std::lower_bound(std::begin(entities), std::end(entities), unicode,
+        [](const Entity & lhs, char32_t rhs) { return lhs.unicode < rhs; })};
+
+    if (entity == std::end(entities) || entity->unicode != unicode)
+        return nullptr;
+
+    return entity;
+}
+
+/**
+ * @brief Write the character reference for a unicode value, using the
+ * entity name if requested and one exists, otherwise a numeric reference.
+ * 
+ * @param sink the output to write to.
+ * @param unicode value of the character to replace.
+ * @param options the escaping options.
+ */
+template<Sink S>
+void writeReference(S & sink, char32_t unicode, const EscapeOptions & options)
+{
+    char work[entityNameMax + 4]{ '&' };
+    char * p{work + 1};
+
+    // ASCII characters with names are handled by the escaping table.
+    const Entity * entity{};
+    if (options.namedEntities && options.mode != EscapeMode::xml && unicode >= 0x80)
+        entity = findEntity(unicode);
+
+    if (entity)
+        p = std::copy(entity->name, entity->name + entity->length, p);
+    else
+    {
+        *p++ = '#';
+        if (options.hexadecimal)
+            *p++ = 'x';
+        char * digits{p};
+        p = std::to_chars(p, work + sizeof(work), (uint32_t)unicode, options.hexadecimal ? 16 : 10).ptr;
+        std::transform(digits, p, digits, [](char c) { return c >= 'a' ? (char)(c - 'a' + 'A') : c; });
+    }
+    *p++ = ';';
+
+    sink.append(work, p - work);
+}
+
+/**
+ * @brief Escape a string buffer to a sink. Runs of ASCII characters that do
+ * not need escaping are found by the findEscape kernel and copied as a block,
+ * as are runs of valid UTF-8 unless every character that is not ASCII is to
+ * be replaced. Invalid UTF-8 bytes are treated as ISO/IEC 8859-1 characters
+ * and always replaced.
+ * 
+ * @param buffer the string to escape.
+ * @param options the escaping options.
+ * @param sink the output to write to.
+ */
+template<Sink S>
+void escapeTo(const std::string_view & buffer, const EscapeOptions & options, S & sink)
+{
+    const EscapeTable & table{escapeTables[(int)options.mode]};
+    const char * p{buffer.data()};
+    const char * end{p + buffer.length()};
+
+    while (p != end)
+    {
+        const char * stop{findEscape(p, end, table.specials, true)};
+        sink.append(p, stop - p);
+        p = stop;
+
+        // Copy valid UTF-8 up to the next ASCII character needing escaping.
+        if (!options.asciiOnly && p != end && (unsigned char)*p >= 0x80)
+        {
+            stop = validateUtf8(p, findEscape(p, end, table.specials, false));
+            sink.append(p, stop - p);
+            p = stop;
+        }
+
+        if (p == end)
+            break;
+
+        const unsigned char c{(unsigned char)*p};
+        if (c == '\t' || c == '\n' || c == '\r')
+        {
+            sink.append(p++, 1);
+            continue;
+        }
+
+        if (c < 128 && !table.names[c].empty())
+        {
+            sink.append(table.names[c].data(), table.names[c].length());
+            ++p;
+            continue;
+        }
+
+        // A control character, an apostrophe in HTML or a character that is
+        // not ASCII, which may be an invalid byte.
+        char32_t unicode{c};
+        size_t length{sequenceLength(p, end)};
+        if (length)
+            unicode = decodeSequence(p, length);
+        else
+            length = 1;
+
+        writeReference(sink, unicode, options);
+        p += length;
+    }
+}
+
+/**
+ * @brief Determine the length of a string buffer after escaping.
+ * 
+ * @param buffer the string to escape.
+ * @param options the escaping options.
+ * @return size_t the length of the escaped string.
+ */
+size_t escapedLength(const std::string_view & buffer, const EscapeOptions & options)
+{
+    CountSink sink{};
+    escapeTo(buffer, options, sink);
+
+    return sink.size;
+}
+
+/**
+ * @brief Write a string buffer to output, replacing the characters that need
+ * escaping for the selected mode with character references.
+ * 
+ * @param buffer the string to escape.
+ * @param output must have room for escapedLength(buffer, options) characters.
+ * @param options the escaping options.
+ * @return char * pointing past the last character written.
+ */
+char * writeEscaped(const std::string_view & buffer, char * output, const EscapeOptions & options)
+{
+    PointerSink sink{output};
+    escapeTo(buffer, options, sink);
+
+    return sink.output;
+}
+
+/**
+ * @brief Write a string buffer to a sink, replacing the characters that need
+ * escaping for the selected mode with character references.
+ * 
+ * @param buffer the string to escape.
+ * @param sink to append the escaped string to.
+ * @param options the escaping options.
+ */
+void writeEscaped(const std::string_view & buffer, SinkRef sink, const EscapeOptions & options)
+{
+    escapeTo(buffer, options, sink);
+}
+
+/**
+ * @brief Replace the characters in a string buffer that need escaping for
+ * the selected mode with character references.
+ * 
+ * @param buffer the string to escape.
+ * @param options the escaping options.
+ */
+void escape(std::string & buffer, const EscapeOptions & options)
+{
+    // Every reference is longer than the bytes it replaces, so an unchanged
+    // length means there is nothing to replace.
+    const size_t size{escapedLength(buffer, options)};
+    if (size == buffer.length())
+        return;
+
+    std::string work(size, '\0');
+    writeEscaped(buffer, work.data(), options);
+    buffer.swap(work);
+}
+
+/**
+ * @brief Get a copy of a string buffer with the characters that need
+ * escaping for the selected mode replaced by character references.
+ * 
+ * @param buffer the string to escape.
+ * @param options the escaping options.
+ * @return std::string the escaped string.
+ */
+std::string escapeCopy(const std::string_view & buffer, const EscapeOptions & options)
+{
+    std::string work{};
+    work.reserve(buffer.length());
+    escapeTo(buffer, options, work);
+
+    return work;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// HTML & XML unescaping.
+
+/**
+ * @brief Find the unicode value of an HTML 4.01 or XML named entity using the
+ * perfect hash, so that only one name is ever compared.
+ * 
+ * @param name of the entity, without the '&' and ';'.
+ * @param length of the name.
+ * @return char32_t the unicode value, or 0 if there is no such entity.
+ */
+char32_t entityValue(const char * name, size_t length)
+{
+    if (length == 0 || length > entityNameMax)
+        return 0;
+
+    const uint8_t seed{entitySeeds[entityHash(name, length, 0) % entityBuckets]};
+    const uint8_t slot{entitySlots[entityHash(name, length, seed) % entitySlotCount]};
+    if (!slot)
+        return 0;
+
+    const Entity & entity{entities[slot - 1]};
+    if (entity.length != length || std::memcmp(entity.name, name, length) != 0)
+        return 0;
+
+    return entity.unicode;
+}
+
+/**
+ * @brief Determine if a byte may be part of an entity name.
+ * 
+ * @param c the byte to check.
+ * @return true if c is an ASCII letter or digit.
+ */
+inline bool isNameChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+}
+
+/**
+ * @brief Decode the character reference at the start of a buffer. Numeric
+ * references to values that cannot be encoded as UTF-8, or to 0, give U+FFFD.
+ * 
+ * @param p points to the '&' starting the reference.
+ * @param end points past the last byte available.
+ * @param unicode returned value of the character reference.
+ * @return size_t length of the reference including the ';', or 0 if p does
+ * not start a complete, known reference.
+ */
+size_t parseReference(const char * p, const char * end, char32_t & unicode)
+{
+    const char * q{p + 1};
+    if (q != end && *q == '#')
+    {
+        int base{10};
+        if (++q != end && (*q == 'x' || *q == 'X'))
+        {
+            base = 16;
+            ++q;
+        }
+
+        uint32_t value{};
+        const auto [last, error]{std::from_chars(q, end, value, base)};
+        if (last == q || last == end || *last != ';')
+            return 0;
+
+        const bool valid{error == std::errc{} && value != 0 && encodedLength((char32_t)value) != 0};
+        unicode = valid ? (char32_t)value : replacementCharacter;
+
+        return last + 1 - p;
+    }
+
+    const char * name{q};
+    for (; q != end && isNameChar(*q); ++q)
+        if (q - name == entityNameMax)
+            return 0;
+
+    if (q == end || *q != ';')
+        return 0;
+
+    unicode = entityValue(name, q - name);
+
+    return unicode ? q + 1 - p : 0;
+}
+
+/**
+ * @brief Write a given string to a sink, replacing decimal, hexadecimal,
+ * HTML 4.01 and XML named character references with the UTF-8 characters
+ * they refer to. Anything else starting with '&' is copied unchanged.
+ * 
+ * @param buffer containing the character references to be replaced.
+ * @param sink to append the unescaped string to.
+ */
+template<Sink S>
+void unescapeTo(const std::string_view & buffer, S & sink)
+{
+    const char * p{buffer.data()};
+    const char * end{p + buffer.length()};
+
+    while (p != end)
+    {
+        // Append the run of characters up to the next '&'.
+        const void * found{std::memchr(p, '&', end - p)};
+        const char * amp{found ? (const char *)found : end};
+        sink.append(p, amp - p);
+        p = amp;
+        if (p == end)
+            break;
+
+        char32_t unicode{};
+        const size_t length{parseReference(p, end, unicode)};
+        if (!length)
+        {
+            sink.append(p++, 1);
+            continue;
+        }
+
+        char work[4];
+        const size_t size{encodedLength(unicode)};
+        encodeSequence(unicode, size, work);
+        sink.append(work, size);
+        p += length;
+    }
+}
+
+/**
+ * @brief Write a given string to output, replacing decimal, hexadecimal,
+ * HTML 4.01 and XML named character references with the UTF-8 characters
+ * they refer to. No reference is shorter than its character, so output may
+ * be the buffer itself.
+ * 
+ * @param buffer containing the character references to be replaced.
+ * @param output must have room for buffer.length() characters.
+ * @return char * pointing past the last character written.
+ */
+char * writeUnescaped(const std::string_view & buffer, char * output)
+{
+    PointerSink sink{output};
+    unescapeTo(buffer, sink);
+
+    return sink.output;
+}
+
+/**
+ * @brief Write a given string to a sink, replacing the character references
+ * with the UTF-8 characters they refer to.
+ * 
+ * @param buffer containing the character references to be replaced.
+ * @param sink to append the unescaped string to.
+ */
+void writeUnescaped(const std::string_view & buffer, SinkRef sink)
+{
+    unescapeTo(buffer, sink);
+}
+
+/**
+ * @brief Replace the character references in a given string with the UTF-8
+ * characters they refer to, in place.
+ * 
+ * @param buffer containing the character references to be replaced.
+ */
+void unescape(std::string & buffer)
+{
+    const char * last{writeUnescaped(buffer, buffer.data())};
+    buffer.resize(last - buffer.data());
+}
+
+/**
+ * @brief Get a copy of a given string with the character references replaced
+ * by the UTF-8 characters they refer to.
+ * 
+ * @param buffer containing the character references to be replaced.
+ * @return std::string the unescaped string.
+ */
+std::string unescapeCopy(const std::string_view & buffer)
+{
+    std::string work(buffer.length(), '\0');
+    const char * last{writeUnescaped(buffer, work.data())};
+    work.resize(last - work.data());
+
+    return work;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Change case for a UTF-8 string.
+
+/**
+ * @brief Get the case mapping differences for a unicode value from the
+ * generated two level tables.
+ * 
+ * @param unicode value to look up.
+ * @return const CaseDelta & differences to the upper, lower and folded values.
+ */
+inline const CaseDelta & caseDelta(char32_t unicode)
+{
+    if (unicode >= caseLimit)
+        return caseDeltas[0];
+
+    const uint8_t block{caseIndex[unicode >> caseBlockBits]};
+
+    return caseDeltas[caseBlocks[block][unicode & ((1 << caseBlockBits) - 1)]];
+}
+
+/**
+ * @brief Get the simple uppercase mapping of a unicode value.
+ * 
+ * @param unicode value to map.
+ * @return char32_t the uppercase value, or unicode if it has none.
+ */
+char32_t upperCase(char32_t unicode)
+{
+    return unicode + caseDelta(unicode).upper;
+}
+
+/**
+ * @brief Get the simple lowercase mapping of a unicode value.
+ * 
+ * @param unicode value to map.
+ * @return char32_t the lowercase value, or unicode if it has none.
+ */
+char32_t lowerCase(char32_t unicode)
+{
+    return unicode + caseDelta(unicode).lower;
+}
+
+/**
+ * @brief Get the simple case folding of a unicode value.
+ * 
+ * @param unicode value to map.
+ * @return char32_t the case folded value, or unicode if it has none.
+ */
+char32_t foldCase(char32_t unicode)
+{
+    return unicode + caseDelta(unicode).fold;
+}
+
+/**
+ * @brief The tables and ASCII letters used for converting to one case.
+ */
+struct CaseMapping
+{
+    int32_t CaseDelta::* delta;         // Simple mapping.
+    uint8_t flag;                       // Full mapping is in specials.
+    std::span<const SpecialCase> specials;
+    char first;                         // First ASCII letter to convert.
+};
+
+constexpr CaseMapping upperMapping{&CaseDelta::upper, UPPER_SPECIAL, upperSpecials, 'a'};
+constexpr CaseMapping lowerMapping{&CaseDelta::lower, LOWER_SPECIAL, lowerSpecials, 'A'};
+constexpr CaseMapping foldMapping{&CaseDelta::fold, FOLD_SPECIAL, foldSpecials, 'A'};
+
+/**
+ * @brief Map the character at p to another case in place, provided the
+ * mapped character has the same UTF-8 byte count.
+ * 
+ * @param p points to the character to map.
+ * @param end of the buffer.
+ * @param mapping the case to convert to.
+ * @param changed returned true if the character was mapped.
+ * @return size_t the UTF-8 byte count, or 0 if not a valid character.
+ */
+size_t mapCase(char * p, char * end, const CaseMapping & mapping, bool & changed)
+{
+    const size_t len{sequenceLength((const unsigned char *)p, (const unsigned char *)end)};
+    if (!len)
+        return 0;
+
+    const char32_t unicode{decodeSequence((const unsigned char *)p, len)};
+    const int32_t difference{caseDelta(unicode).*mapping.delta};
+
+    changed = (difference != 0) && (encodedLength(unicode + difference) == len);
+    if (changed)
+        encodeSequence(unicode + difference, len, p);
+
+    return len;
+}
+
+/**
+ * @brief Convert a lowercase character to uppercase at the start of string.
+ * Characters whose uppercase has a different UTF-8 byte count are unchanged.
+ * 
+ * @param buffer possibly starting with an ASCII or UTF-8 lowercase character.
+ * @return int the UTF-8 byte count if converted, 0 otherwise.
+ */
+int toUpper(std::string & buffer)
+{
+    char * p{buffer.data()};
+    bool changed{};
+    const size_t len{mapCase(p, p + buffer.length(), upperMapping, changed)};
+
+    return changed ? len : 0;
+}
+
+/**
+ * @brief Convert a uppercase character to lowercase at the start of string.
+ * Characters whose lowercase has a different UTF-8 byte count are unchanged.
+ * 
+ * @param buffer possibly starting with an ASCII or UTF-8  uppercase character.
+ * @return int the UTF-8 byte count if converted, 0 otherwise.
+ */
+int toLower(std::string & buffer)
+{
+    char * p{buffer.data()};
+    bool changed{};
+    const size_t len{mapCase(p, p + buffer.length(), lowerMapping, changed)};
+
+    return changed ? len : 0;
+}
+
+/**
+ * @brief Convert the case of all characters in the given string in place,
+ * converting runs of ASCII with the fastest available kernel.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 characters.
+ * @param mapping the case to convert to.
+ */
+void changeCase(std::string & buffer, const CaseMapping & mapping)
+{
+    char * p{buffer.data()};
+    char * const end{p + buffer.length()};
+
+    while ((p = flipAscii(p, end, mapping.first)) != end)
+    {
+        // Skip over any invalid bytes.
+        bool changed{};
+        const size_t len{mapCase(p, end, mapping, changed)};
+        p += len ? len : 1;
+    }
+}
+
+/**
+ * @brief Convert lowercase characters to uppercase in the given string.
+ * Characters whose uppercase has a different UTF-8 byte count are unchanged.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 lowercase characters.
+ */
+void makeUpper(std::string & buffer)
+{
+    changeCase(buffer, upperMapping);
+}
+
+/**
+ * @brief Convert uppercase characters to lowercase in the given string.
+ * Characters whose lowercase has a different UTF-8 byte count are unchanged.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 uppercase characters.
+ */
+void makeLower(std::string & buffer)
+{
+    changeCase(buffer, lowerMapping);
+}
+
+/**
+ * @brief Determine the worst case number of bytes that converting the case
+ * of a string of the given length can produce.
+ * 
+ * @param length of the string to convert in bytes.
+ * @return size_t the number of bytes the output must be able to hold.
+ */
+size_t caseCopyBound(size_t length)
+{
+    return length * caseExpansion;
+}
+
+/**
+ * @brief Write the given string to output with the case of all characters
+ * converted using the full (unconditional) mappings, which may change the
+ * length. Invalid bytes are copied unchanged.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 characters.
+ * @param output must have room for caseCopyBound(buffer.length()) bytes.
+ * @param mapping the case to convert to.
+ * @return char * pointing past the last byte written.
+ */
+char * copyCase(const std::string_view & buffer, char * output, const CaseMapping & mapping)
+{
+    const char * p{buffer.data()};
+    const char * const end{p + buffer.length()};
+
+    while (p < end)
+    {
+        // Copy a block and convert any leading ASCII in place. The bound
+        // guarantees room for the block as it is never smaller than the
+        // remaining input.
+        const size_t block{std::min<size_t>(end - p, 64)};
+        std::memcpy(output, p, block);
+        const size_t ascii{(size_t)(flipAscii(output, output + block, mapping.first) - output)};
+        p += ascii;
+        output += ascii;
+        if (ascii == block)
+            continue;
+
+        const unsigned char * lead{(const unsigned char *)p};
+        const size_t len{sequenceLength(lead, (const unsigned char *)end)};
+        if (!len)
+        {
+            // Already copied.
+            ++p;
+            ++output;
+            continue;
+        }
+
+        const char32_t unicode{decodeSequence(lead, len)};
+        const CaseDelta & entry{caseDelta(unicode)};
+        p += len;
+
+        if (entry.special & mapping.flag)
+        {
+            const auto special{std::lower_bound(mapping.specials.begin(), mapping.specials.end(), unicode,
+                [](const SpecialCase & item, char32_t value) { return item.unicode < value; })};
+            output = std::copy(special->utf8, special->utf8 + special->length, output);
+            continue;
+        }
+
+        const char32_t mapped{unicode + entry.*mapping.delta};
+        const size_t mappedLen{encodedLength(mapped)};
+        encodeSequence(mapped, mappedLen, output);
+        output += mappedLen;
+    }
+
+    return output;
+}
+
+/**
+ * @brief Generate a copy of the given string with the case of all characters
+ * converted, allocating the worst case size once.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 characters.
+ * @param mapping the case to convert to.
+ * @return std::string the converted string.
+ */
+std::string copyCase(const std::string_view & buffer, const CaseMapping & mapping)
+{
+    std::string output(caseCopyBound(buffer.length()), '\0');
+    output.resize(copyCase(buffer, output.data(), mapping) - output.data());
+
+    return output;
+}
+
+/**
+ * @brief Write the given string to a sink with the case of all characters
+ * converted, a block at a time, so that the worst case output buffer is only
+ * needed for one block and is never allocated.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 characters.
+ * @param sink to append the converted string to.
+ * @param mapping the case to convert to.
+ */
+void copyCase(const std::string_view & buffer, SinkRef sink, const CaseMapping & mapping)
+{
+    constexpr size_t BLOCK{4096};
+    char block[caseExpansion * BLOCK];
+
+    for (std::string_view rest{buffer}; !rest.empty(); )
+    {
+        const std::string_view part{truncateToBytes(rest, BLOCK)};
+        const char * last{copyCase(part, block, mapping)};
+        sink.append(block, last - block);
+        rest.remove_prefix(part.length());
+    }
+}
+
+/**
+ * @brief Write the given string to output with all characters converted to
+ * uppercase, including those that change length, such as 'ß' to "SS".
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 lowercase characters.
+ * @param output must have room for caseCopyBound(buffer.length()) bytes.
+ * @return char * pointing past the last byte written.
+ */
+char * toUpperCopy(const std::string_view & buffer, char * output)
+{
+    return copyCase(buffer, output, upperMapping);
+}
+
+/**
+ * @brief Write the given string to output with all characters converted to
+ * lowercase, including those that change length, such as 'İ' to "i̇".
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 uppercase characters.
+ * @param output must have room for caseCopyBound(buffer.length()) bytes.
+ * @return char * pointing past the last byte written.
+ */
+char * toLowerCopy(const std::string_view & buffer, char * output)
+{
+    return copyCase(buffer, output, lowerMapping);
+}
+
+/**
+ * @brief Write the given string to output with full case folding applied, for
+ * case insensitive comparison.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 characters.
+ * @param output must have room for caseCopyBound(buffer.length()) bytes.
+ * @return char * pointing past the last byte written.
+ */
+char * caseFold(const std::string_view & buffer, char * output)
+{
+    return copyCase(buffer, output, foldMapping);
+}
+
+/**
+ * @brief Generate a copy of the given string with all characters converted
+ * to uppercase, including those that change length.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 lowercase characters.
+ * @return std::string the uppercase string.
+ */
+std::string toUpperCopy(const std::string_view & buffer)
+{
+    return copyCase(buffer, upperMapping);
+}
+
+/**
+ * @brief Generate a copy of the given string with all characters converted
+ * to lowercase, including those that change length.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 uppercase characters.
+ * @return std::string the lowercase string.
+ */
+std::string toLowerCopy(const std::string_view & buffer)
+{
+    return copyCase(buffer, lowerMapping);
+}
+
+/**
+ * @brief Generate a copy of the given string with full case folding applied,
+ * for case insensitive comparison.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 characters.
+ * @return std::string the case folded string.
+ */
+std::string caseFold(const std::string_view & buffer)
+{
+    return copyCase(buffer, foldMapping);
+}
+
+/**
+ * @brief Write the given string to a sink with all characters converted to
+ * uppercase, as toUpperCopy().
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 lowercase characters.
+ * @param sink to append the uppercase string to.
+ */
+void toUpperCopy(const std::string_view & buffer, SinkRef sink)
+{
+    copyCase(buffer, sink, upperMapping);
+}
+
+/**
+ * @brief Write the given string to a sink with all characters converted to
+ * lowercase, as toLowerCopy().
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 uppercase characters.
+ * @param sink to append the lowercase string to.
+ */
+void toLowerCopy(const std::string_view & buffer, SinkRef sink)
+{
+    copyCase(buffer, sink, lowerMapping);
+}
+
+/**
+ * @brief Write the given string to a sink with all characters case folded,
+ * as caseFold().
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 characters.
+ * @param sink to append the case folded string to.
+ */
+void caseFold(const std::string_view & buffer, SinkRef sink)
+{
+    copyCase(buffer, sink, foldMapping);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Parallel processing of large buffers.
+
+/**
+ * @brief Find the first character boundary at or after pos. At most three
+ * continuation bytes are skipped, so a long run of stray continuation bytes
+ * may still be split, but never a valid character.
+ * 
+ * @param buffer possibly containing UTF-8 characters.
+ * @param pos byte offset to start from.
+ * @return size_t offset of the boundary.
+ */
+size_t nextBoundary(const std::string_view & buffer, size_t pos)
+{
+    for (int i{}; (i < 3) && (pos < buffer.length()) && ((buffer[pos] & 0xC0) == 0x80); ++i)
+        ++pos;
+
+    return std::min(pos, buffer.length());
+}
+
+/**
+ * @brief Split the string buffer into count roughly equal chunks without
+ * splitting any valid UTF-8 character, so each chunk can be processed
+ * independently with the same result as processing the whole buffer.
+ * 
+ * @param buffer possibly containing UTF-8 characters.
+ * @param count of chunks required, 0 for one per hardware thread.
+ * @return std::vector<std::string_view> the chunks, in order.
+ */
+std::vector<std::string_view> splitChunks(const std::string_view & buffer, size_t count)
+{
+    if (count == 0)
+        count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    count = std::clamp<size_t>(count, 1, std::max<size_t>(buffer.length(), 1));
+    const size_t step{buffer.length() / count};
+
+    std::vector<std::string_view> chunks{};
+    chunks.reserve(count);
+    size_t start{};
+    for (size_t i{1}; i <= count; ++i)
+    {
+        const size_t end{(i == count) ? buffer.length() : std::max(nextBoundary(buffer, i * step), start)};
+        chunks.push_back(buffer.substr(start, end - start));
+        start = end;
+    }
+
+    return chunks;
+}
+
+/**
+ * @brief Split the string buffer into one chunk per thread, but only if each
+ * chunk would be at least parallelThreshold bytes.
+ * 
+ * @param buffer possibly containing UTF-8 characters.
+ * @param threads maximum to use, 0 for one per hardware thread.
+ * @return std::vector<std::string_view> the chunks, in order.
+ */
+std::vector<std::string_view> parallelChunks(const std::string_view & buffer, unsigned threads)
+{
+    if (threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    return splitChunks(buffer, std::clamp<size_t>(buffer.length() / parallelThreshold, 1, threads));
+}
+
+/**
+ * @brief Call func with the index of every chunk, the first on the calling
+ * thread and each of the others on its own thread. The threads are started
+ * and joined by every call, which is why buffers are only split into chunks
+ * of at least parallelThreshold bytes.
+ * 
+ * @param count of chunks.
+ * @param func callable taking the chunk index.
+ */
+template<typename F>
+void forEachChunk(size_t count, F func)
+{
+    std::vector<std::thread> threads{};
+    threads.reserve(count);
+    for (size_t i{1}; i < count; ++i)
+        threads.emplace_back(func, i);
+
+    func(0);
+
+    for (auto & thread : threads)
+        thread.join();
+}
+
+/**
+ * @brief Find the first invalid byte as findInvalid(), using multiple threads
+ * for large buffers.
+ * 
+ * @param buffer possibly containing UTF-8 characters.
+ * @param threads maximum to use, 0 for one per hardware thread.
+ * @return size_t offset of the first invalid byte, or std::string_view::npos
+ *         if buffer contains only valid UTF-8.
+ */
+size_t findInvalidParallel(const std::string_view & buffer, unsigned threads)
+{
+    const std::vector<std::string_view> chunks{parallelChunks(buffer, threads)};
+    if (chunks.size() == 1)
+        return findInvalid(buffer);
+
+    std::vector<size_t> invalid(chunks.size());
+    forEachChunk(chunks.size(), [&](size_t i) { invalid[i] = findInvalid(chunks[i]); });
+
+    for (size_t i{}; i < chunks.size(); ++i)
+        if (invalid[i] != std::string_view::npos)
+            return chunks[i].data() - buffer.data() + invalid[i];
+
+    return std::string_view::npos;
+}
+
+/**
+ * @brief Check the string buffer as validate(), using multiple threads for
+ * large buffers.
+ * 
+ * @param buffer possibly containing UTF-8 characters.
+ * @param threads maximum to use, 0 for one per hardware thread.
+ * @return true if buffer contains only valid UTF-8, false otherwise.
+ */
+bool validateParallel(const std::string_view & buffer, unsigned threads)
+{
+    return findInvalidParallel(buffer, threads) == std::string_view::npos;
+}
+
+/**
+ * @brief Count the characters in the string as charCount(), using multiple
+ * threads for large buffers.
+ * 
+ * @param buffer possibly containing UTF-8 characters.
+ * @param threads maximum to use, 0 for one per hardware thread.
+ * @return size_t character count.
+ */
+size_t charCountParallel(const std::string_view & buffer, unsigned threads)
+{
+    const std::vector<std::string_view> chunks{parallelChunks(buffer, threads)};
+    if (chunks.size() == 1)
+        return charCount(buffer);
+
+    std::vector<size_t> counts(chunks.size());
+    forEachChunk(chunks.size(), [&](size_t i) { counts[i] = charCount(chunks[i]); });
+
+    size_t count{};
+    for (auto chunk : counts)
+        count += chunk;
+
+    return count;
+}
+
+/**
+ * @brief Count the characters and malformed bytes in the string as
+ * charCount(), using multiple threads for large buffers.
+ * 
+ * @param buffer possibly containing UTF-8 characters.
+ * @param malformed returned count of bytes not part of a valid character.
+ * @param threads maximum to use, 0 for one per hardware thread.
+ * @return size_t character count.
+ */
+size_t charCountParallel(const std::string_view & buffer, size_t & malformed, unsigned threads)
+{
+    const std::vector<std::string_view> chunks{parallelChunks(buffer, threads)};
+    if (chunks.size() == 1)
+        return charCount(buffer, malformed);
+
+    std::vector<size_t> counts(chunks.size());
+    std::vector<size_t> bad(chunks.size());
+    forEachChunk(chunks.size(), [&](size_t i) { counts[i] = charCount(chunks[i], bad[i]); });
+
+    size_t count{};
+    malformed = 0;
+    for (size_t i{}; i < chunks.size(); ++i)
+    {
+        count += counts[i];
+        malformed += bad[i];
+    }
+
+    return count;
+}
+
+/**
+ * @brief Convert the case of a chunk a block at a time, so that the worst
+ * case output buffer is only needed for one block.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 characters.
+ * @param mapping the case conversion to apply.
+ * @return std::string the converted chunk.
+ */
+std::string copyCaseBlocks(const std::string_view & buffer, const CaseMapping & mapping)
+{
+    std::string output{};
+    output.reserve(buffer.length());
+    copyCase(buffer, output, mapping);
+
+    return output;
+}
+
+/**
+ * @brief Convert the case of each chunk on its own thread, then gather the
+ * converted chunks on the calling thread, appending them to the first.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 characters.
+ * @param mapping the case conversion to apply.
+ * @param threads maximum to use, 0 for one per hardware thread.
+ * @return std::string the converted string.
+ */
+std::string copyCaseParallel(const std::string_view & buffer, const CaseMapping & mapping, unsigned threads)
+{
+    const std::vector<std::string_view> chunks{parallelChunks(buffer, threads)};
+    if (chunks.size() == 1)
+        return copyCase(buffer, mapping);
+
+    std::vector<std::string> converted(chunks.size());
+    forEachChunk(chunks.size(), [&](size_t i) { converted[i] = copyCaseBlocks(chunks[i], mapping); });
+
+    size_t size{};
+    for (const auto & chunk : converted)
+        size += chunk.length();
+
+    std::string output{std::move(converted[0])};
+    output.reserve(size);
+    for (size_t i{1}; i < chunks.size(); ++i)
+        output += converted[i];
+
+    return output;
+}
+
+/**
+ * @brief Generate an uppercase copy as toUpperCopy(), using multiple threads
+ * for large buffers.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 lowercase characters.
+ * @param threads maximum to use, 0 for one per hardware thread.
+ * @return std::string the uppercase string.
+ */
+std::string toUpperCopyParallel(const std::string_view & buffer, unsigned threads)
+{
+    return copyCaseParallel(buffer, upperMapping, threads);
+}
+
+/**
+ * @brief Generate a lowercase copy as toLowerCopy(), using multiple threads
+ * for large buffers.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 uppercase characters.
+ * @param threads maximum to use, 0 for one per hardware thread.
+ * @return std::string the lowercase string.
+ */
+std::string toLowerCopyParallel(const std::string_view & buffer, unsigned threads)
+{
+    return copyCaseParallel(buffer, lowerMapping, threads);
+}
+
+/**
+ * @brief Generate a case folded copy as caseFold(), using multiple threads
+ * for large buffers.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 characters.
+ * @param threads maximum to use, 0 for one per hardware thread.
+ * @return std::string the case folded string.
+ */
+std::string caseFoldParallel(const std::string_view & buffer, unsigned threads)
+{
+    return copyCaseParallel(buffer, foldMapping, threads);
 }
 
 
@@ -24,39 +24,526 @@
 #if !defined(_UTF_8_H__20211017_1938__INCLUDED_)
 #define _UTF_8_H__20211017_1938__INCLUDED_
 
+#include <algorithm>
+#include <concepts>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace utf8 {
 
+/**
+ * @brief Outcome of a bulk conversion. Conversion stops at the first invalid
+ * character, when the output is full or when all the input is consumed.
+ */
+struct ConvertResult
+{
+    size_t consumed{};      // Input elements converted.
+    size_t produced{};      // Output elements written.
+    size_t error{std::string_view::npos};   // Offset of first invalid input.
+};
+
+/**
+ * @brief Error handling policies for the bulk functions, selected at compile
+ * time as a template argument. Strict stops at the first invalid byte,
+ * Replace substitutes U+FFFD for each invalid byte, Skip drops invalid bytes
+ * and Latin1 treats each invalid byte as an ISO/IEC 8859-1 character, as
+ * useCharacterRefs() does.
+ */
+struct Strict {};
+struct Replace {};
+struct Skip {};
+struct Latin1 {};
+
+/**
+ * @brief Escaping modes. HTML text replaces '&', '<' and '>', HTML attribute
+ * and XML also replace both quotes.
+ */
+enum class EscapeMode { htmlText, htmlAttribute, xml };
+
+/**
+ * @brief Escaping options. Control characters other than tab, line feed and
+ * carriage return, and invalid UTF-8 bytes taken as ISO/IEC 8859-1, are
+ * always replaced.
+ */
+struct EscapeOptions
+{
+    EscapeMode mode{EscapeMode::htmlText};
+    bool namedEntities{};   // Use HTML 4.01 names, such as &copy;, except in XML.
+    bool hexadecimal{};     // Use &#xA9; rather than &#169; for numeric references.
+    bool asciiOnly{};       // Replace every character that is not ASCII.
+};
+
+/**
+ * @brief Anything that output can be appended to a run of bytes at a time,
+ * such as std::string or one of the sinks below.
+ */
+template<typename T>
+concept Sink = requires(T & sink, const char * p, size_t length)
+{
+    sink.append(p, length);
+};
+
+/**
+ * @brief A reference to any Sink, so that the functions writing to a sink are
+ * not templates. The sink must outlive the reference.
+ */
+class SinkRef
+{
+public:
+    template<Sink T>
+        requires (!std::is_same_v<std::remove_cv_t<T>, SinkRef>)
+    SinkRef(T & sink) :
+        object{(void *)&sink},
+        write{[](void * object, const char * p, size_t length) { static_cast<T *>(object)->append(p, length); }}
+    {}
+
+    void append(const char * p, size_t length) const { write(object, p, length); }
+
+private:
+    void * object;
+    void (*write)(void * object, const char * p, size_t length);
+
+};
+
+/**
+ * @brief Sink to a fixed size buffer. Output that does not fit is dropped and
+ * the sink marked as overflowed, so it may end part way through a character.
+ */
+class BufferSink
+{
+public:
+    BufferSink(char * buffer, size_t cap) : first{buffer}, next{buffer}, last{buffer + cap} {}
+
+    void append(const char * p, size_t length)
+    {
+        if (length > (size_t)(last - next))
+        {
+            length = last - next;
+            overflow = true;
+        }
+
+        next = std::copy(p, p + length, next);
+    }
+
+    size_t size(void) const { return next - first; }
+    bool overflowed(void) const { return overflow; }
+    std::string_view view(void) const { return std::string_view{first, size()}; }
+
+private:
+    char * first;
+    char * next;
+    char * last;
+    bool overflow{};
+
+};
+
+/**
+ * @brief Sink appending to a vector, with each byte converted to T.
+ */
+template<typename T = char, typename Allocator = std::allocator<T>>
+class VectorSink
+{
+public:
+    explicit VectorSink(std::vector<T, Allocator> & output) : vector{output} {}
+
+    void append(const char * p, size_t length)
+    {
+        if constexpr (sizeof(T) == 1)
+        {
+            const size_t size{vector.size()};
+            vector.resize(size + length);
+            std::copy(p, p + length, (char *)vector.data() + size);
+        }
+        else
+            for (size_t i{}; i < length; ++i)
+                vector.push_back((T)((unsigned char)p[i]));
+    }
+
+private:
+    std::vector<T, Allocator> & vector;
+
+};
+
+/**
+ * @brief Sink passing each run of output to a callable taking a
+ * std::string_view.
+ */
+template<typename F>
+class CallbackSink
+{
+public:
+    explicit CallbackSink(F callback) : function{std::move(callback)} {}
+
+    void append(const char * p, size_t length) { function(std::string_view{p, length}); }
+
+private:
+    F function;
+
+};
+
+/**
+ * @brief Sink writing to a C stream, which does its own buffering.
+ */
+class FileSink
+{
+public:
+    explicit FileSink(std::FILE * stream) : file{stream} {}
+
+    void append(const char * p, size_t length);
+    bool good(void) const { return !failed; }
+
+private:
+    std::FILE * file;
+    bool failed{};
+
+};
+
+#if __has_include(<unistd.h>)
+/**
+ * @brief Sink writing to a POSIX file descriptor, gathering output into a
+ * buffer so that small appends do not each make a system call. The buffer is
+ * written when full, by flush() and on destruction.
+ */
+class FdSink
+{
+public:
+    explicit FdSink(int fd, size_t size = 1 << 16) : descriptor{fd}, buffer(size) {}
+    ~FdSink(void) { flush(); }
+
+    FdSink(const FdSink &) = delete;
+    FdSink & operator=(const FdSink &) = delete;
+
+    void append(const char * p, size_t length);
+    bool flush(void);
+    bool good(void) const { return !failed; }
+
+private:
+    int descriptor;
+    std::vector<char> buffer;
+    size_t used{};
+    bool failed{};
+
+};
+#endif
+
+/**
+ * @brief Determine the number of bytes needed to encode a unicode value as
+ * UTF-8, rejecting surrogates and values above U+10FFFF.
+ * 
+ * @param unicode value to encode as UTF-8.
+ * @return size_t the UTF-8 byte count, or 0 if unicode is not valid.
+ */
+constexpr size_t encodedLength(char32_t unicode)
+{
+    if (unicode < 0x80)
+        return 1;
+
+    if (unicode < 0x800)
+        return 2;
+
+    if (unicode < 0x10000)
+        return ((unicode & 0xF800) == 0xD800) ? 0 : 3;
+
+    return (unicode <= 0x10FFFF) ? 4 : 0;
+}
+
+/**
+ * @brief Encode a unicode value as a UTF-8 character without allocating.
+ * 
+ * @param unicode value to encode as UTF-8.
+ * @param out receives the UTF-8 bytes, any unused bytes are unchanged.
+ * @return size_t the UTF-8 byte count, or 0 if unicode is not valid.
+ */
+constexpr size_t encode(char32_t unicode, char (&out)[4])
+{
+    const size_t len{encodedLength(unicode)};
+
+    switch (len)
+    {
+    case 1:
+        out[0] = (char)unicode;
+        break;
+
+    case 2:
+        out[0] = (char)(0xC0 | (unicode >> 6));
+        out[1] = (char)(0x80 | (unicode & 0x3F));
+        break;
+
+    case 3:
+        out[0] = (char)(0xE0 | (unicode >> 12));
+        out[1] = (char)(0x80 | ((unicode >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (unicode & 0x3F));
+        break;
+
+    case 4:
+        out[0] = (char)(0xF0 | (unicode >> 18));
+        out[1] = (char)(0x80 | ((unicode >> 12) & 0x3F));
+        out[2] = (char)(0x80 | ((unicode >> 6) & 0x3F));
+        out[3] = (char)(0x80 | (unicode & 0x3F));
+        break;
+    }
+
+    return len;
+}
+
+constexpr char32_t replacementCharacter{0xFFFD};
+
+/**
+ * @brief Determine the length of the strictly valid UTF-8 character at p.
+ * Overlong encodings, surrogates and values above U+10FFFF are rejected.
+ * 
+ * @param p points to the first byte of the character.
+ * @param end points past the last byte available.
+ * @return size_t the UTF-8 byte count, or 0 if not a valid UTF-8 character.
+ */
+constexpr size_t sequenceLength(const char * p, const char * end)
+{
+    const unsigned char lead{(unsigned char)*p};
+    if (lead < 0x80)
+        return 1;
+
+    // Set the byte count and the valid range of the second byte.
+    size_t len{};
+    unsigned char low{0x80};
+    unsigned char high{0xBF};
+    if (lead < 0xC2)
+        return 0;
+    else
+    if (lead < 0xE0)
+        len = 2;
+    else
+    if (lead < 0xF0)
+    {
+        len = 3;
+        if (lead == 0xE0)
+            low = 0xA0;         // Overlong.
+        else
+        if (lead == 0xED)
+            high = 0x9F;        // Surrogate.
+    }
+    else
+    if (lead < 0xF5)
+    {
+        len = 4;
+        if (lead == 0xF0)
+            low = 0x90;         // Overlong.
+        else
+        if (lead == 0xF4)
+            high = 0x8F;        // Above U+10FFFF.
+    }
+    else
+        return 0;
+
+    if ((size_t)(end - p) < len)
+        return 0;
+
+    const unsigned char second{(unsigned char)p[1]};
+    if ((second < low) || (second > high))
+        return 0;
+
+    for (size_t i{2}; i < len; ++i)
+        if (((unsigned char)p[i] & 0xC0) != 0x80)
+            return 0;
+
+    return len;
+}
+
+/**
+ * @brief Decode the strictly valid UTF-8 character of length len at p.
+ * 
+ * @param p points to the first byte of the character.
+ * @param len the UTF-8 byte count from sequenceLength().
+ * @return char32_t the decoded value.
+ */
+constexpr char32_t decodeSequence(const char * p, size_t len)
+{
+    auto byte = [p](size_t i) { return (char32_t)(unsigned char)p[i]; };
+
+    switch (len)
+    {
+    case 1: return byte(0);
+    case 2: return ((byte(0) & 0x1F) << 6) | (byte(1) & 0x3F);
+    case 3: return ((byte(0) & 0x0F) << 12) | ((byte(1) & 0x3F) << 6) | (byte(2) & 0x3F);
+    }
+
+    return ((byte(0) & 0x07) << 18) | ((byte(1) & 0x3F) << 12) | ((byte(2) & 0x3F) << 6) | (byte(3) & 0x3F);
+}
+
+/**
+ * @brief Find the start of the character before pos. A valid character ending
+ * at pos starts within the 3 bytes before its last byte, otherwise the byte
+ * before pos is invalid and is treated as a character on its own. Only the
+ * bytes before pos are examined, so stepping back is constant time.
+ * 
+ * @param buffer possibly containing UTF-8 characters.
+ * @param pos offset of a character boundary, greater than 0.
+ * @return size_t offset of the start of the previous character.
+ */
+constexpr size_t prevCharStart(std::string_view buffer, size_t pos)
+{
+    size_t lead{pos - 1};
+    for (int i{}; (i < 3) && (lead > 0) && (((unsigned char)buffer[lead] & 0xC0) == 0x80); ++i)
+        --lead;
+
+    const char * begin{buffer.data()};
+    const size_t len{sequenceLength(begin + lead, begin + buffer.length())};
+
+    return (len == pos - lead) ? lead : pos - 1;
+}
+
+/**
+ * @brief Decode the character before pos and step pos back to its start.
+ * 
+ * @param buffer possibly containing UTF-8 characters.
+ * @param pos offset of a character boundary, greater than 0, returned as the
+ *        start of the previous character.
+ * @return char32_t the unicode value, or U+FFFD if the byte is invalid.
+ */
+constexpr char32_t decodePrev(std::string_view buffer, size_t & pos)
+{
+    const size_t start{prevCharStart(buffer, pos)};
+    const char * begin{buffer.data()};
+    const size_t len{sequenceLength(begin + start, begin + buffer.length())};
+    pos = start;
+
+    return len ? decodeSequence(begin + start, len) : replacementCharacter;
+}
+
+/**
+ * @brief A single UTF-8 character held by value, up to 4 bytes. It can be
+ * built at compile time and never touches the heap.
+ */
+class Character
+{
+public:
+    constexpr Character(void) {}
+    constexpr explicit Character(char32_t unicode) : length{(unsigned char)encode(unicode, bytes)} {}
+
+    constexpr size_t size(void) const { return length; }
+    constexpr bool empty(void) const { return length == 0; }
+    constexpr const char * data(void) const { return bytes; }
+    constexpr const char * begin(void) const { return bytes; }
+    constexpr const char * end(void) const { return bytes + length; }
+    constexpr char operator[](size_t i) const { return bytes[i]; }
+
+    constexpr std::string_view view(void) const { return std::string_view{bytes, length}; }
+    constexpr operator std::string_view(void) const { return view(); }
+
+private:
+    char bytes[4]{};
+    unsigned char length{};
+
+};
+
 extern size_t getUtf8Length(int unicode, char & lead);
 extern std::string unicodeToUtf8(int unicode);
+extern bool unicodeToUtf8(int unicode, SinkRef sink);
 extern bool utf8ToUnicode(const std::string_view & buffer, int & unicode, int & length);
 extern size_t charCount(const std::string_view & buffer);
+extern size_t charCount(const std::string_view & buffer, size_t & malformed);
+
+extern bool validate(const std::string_view & buffer);
+extern size_t findInvalid(const std::string_view & buffer);
+
+extern ConvertResult decode(const std::string_view & in, char32_t * out, size_t cap);
+extern size_t encodedLength(std::span<const char32_t> in);
+extern ConvertResult encode(std::span<const char32_t> in, char * out, size_t cap);
+extern ConvertResult encode(std::span<const char32_t> in, SinkRef sink);
+
+extern size_t latin1ToUtf8Length(const std::string_view & in);
+extern ConvertResult latin1ToUtf8(const std::string_view & in, char * out, size_t cap);
+extern std::string latin1ToUtf8(const std::string_view & in);
+extern void latin1ToUtf8(const std::string_view & in, SinkRef sink);
+extern ConvertResult utf8ToLatin1(const std::string_view & in, char * out, size_t cap);
+extern ConvertResult utf8ToLatin1(const std::string_view & in, char * out, size_t cap, char substitute);
+
+template<typename Policy> size_t charCount(const std::string_view & buffer);
+template<typename Policy> ConvertResult decode(const std::string_view & in, char32_t * out, size_t cap);
+template<typename Policy> ConvertResult decode(const std::string_view & in, char16_t * out, size_t cap);
+template<typename Policy = Replace> size_t sanitize(std::string & buffer);
 
+extern size_t utf16Length(const std::string_view & in);
+extern ConvertResult decode(const std::string_view & in, char16_t * out, size_t cap);
+extern size_t encodedLength(std::span<const char16_t> in);
+extern ConvertResult encode(std::span<const char16_t> in, char * out, size_t cap);
+extern ConvertResult encode(std::span<const char16_t> in, SinkRef sink);
+
+extern std::string_view truncateToBytes(const std::string_view & buffer, size_t maxBytes);
+extern std::string_view truncateToChars(const std::string_view & buffer, size_t count);
+
+extern size_t characterRefsLength(const std::string_view & buffer);
+extern char * writeCharacterRefs(const std::string_view & buffer, char * output);
+extern void writeCharacterRefs(const std::string_view & buffer, SinkRef sink);
 extern void useCharacterRefs(std::string & buffer);
 extern std::string useCharacterRefs(const std::string & buffer);
 
+extern size_t escapedLength(const std::string_view & buffer, const EscapeOptions & options = {});
+extern char * writeEscaped(const std::string_view & buffer, char * output, const EscapeOptions & options = {});
+extern void writeEscaped(const std::string_view & buffer, SinkRef sink, const EscapeOptions & options = {});
+extern void escape(std::string & buffer, const EscapeOptions & options = {});
+extern std::string escapeCopy(const std::string_view & buffer, const EscapeOptions & options = {});
+
+extern char * writeUnescaped(const std::string_view & buffer, char * output);
+extern void writeUnescaped(const std::string_view & buffer, SinkRef sink);
+extern void unescape(std::string & buffer);
+extern std::string unescapeCopy(const std::string_view & buffer);
+
+extern char32_t upperCase(char32_t unicode);
+extern char32_t lowerCase(char32_t unicode);
+extern char32_t foldCase(char32_t unicode);
 extern int toUpper(std::string & buffer);
 extern int toLower(std::string & buffer);
 extern void makeUpper(std::string & buffer);
 extern void makeLower(std::string & buffer);
 
+extern size_t caseCopyBound(size_t length);
+extern char * toUpperCopy(const std::string_view & buffer, char * output);
+extern char * toLowerCopy(const std::string_view & buffer, char * output);
+extern char * caseFold(const std::string_view & buffer, char * output);
+extern std::string toUpperCopy(const std::string_view & buffer);
+extern std::string toLowerCopy(const std::string_view & buffer);
+extern std::string caseFold(const std::string_view & buffer);
+extern void toUpperCopy(const std::string_view & buffer, SinkRef sink);
+extern void toLowerCopy(const std::string_view & buffer, SinkRef sink);
+extern void caseFold(const std::string_view & buffer, SinkRef sink);
+
+// The parallel versions start and join their own threads on every call, so
+// a buffer is only split when each thread gets at least this many bytes.
+constexpr size_t parallelThreshold{1 << 20};
+
+extern std::vector<std::string_view> splitChunks(const std::string_view & buffer, size_t count);
+extern size_t findInvalidParallel(const std::string_view & buffer, unsigned threads = 0);
+extern bool validateParallel(const std::string_view & buffer, unsigned threads = 0);
+extern size_t charCountParallel(const std::string_view & buffer, unsigned threads = 0);
+extern size_t charCountParallel(const std::string_view & buffer, size_t & malformed, unsigned threads = 0);
+extern std::string toUpperCopyParallel(const std::string_view & buffer, unsigned threads = 0);
+extern std::string toLowerCopyParallel(const std::string_view & buffer, unsigned threads = 0);
+extern std::string caseFoldParallel(const std::string_view & buffer, unsigned threads = 0);
+
 
 /**
  * @brief Generate a UTF-8 character as a vector from unicode.
  * 
  * @param unicode value to encode as a UTF-8 character.
- * @return std::vector<T> of the encoded UTF-8 character. 
+ * @param allocator to allocate the vector with.
+ * @return std::vector<T, Allocator> of the encoded UTF-8 character. 
  */
-template<typename T = char>
-std::vector<T> unicodeToUtf8Vector(int unicode)
+template<typename T = char, typename Allocator = std::allocator<T>>
+std::vector<T, Allocator> unicodeToUtf8Vector(int unicode, const Allocator & allocator = Allocator{})
 {
     // Get UTF-8 length and get first byte with getUtf8Length().
     char buffer{};
     const size_t len{getUtf8Length(unicode, buffer)};
 
-    std::vector<T> output{};
+    std::vector<T, Allocator> output(allocator);
     if (!len)
         return output;
 
@@ -76,6 +563,675 @@ std::vector<T> unicodeToUtf8Vector(int unicode)
     return output;
 }
 
+/**
+ * @brief Encode unicode values as UTF-8 characters to an output iterator.
+ * The values are encoded a block at a time into a local buffer, so there is
+ * no allocation. Encoding stops at the first invalid value.
+ * 
+ * @param in unicode values to encode.
+ * @param out iterator to receive the UTF-8 bytes.
+ * @return OutputIt past the last byte written.
+ */
+template<typename OutputIt>
+    requires (!Sink<OutputIt>)
+OutputIt encode(std::span<const char32_t> in, OutputIt out)
+{
+    char block[1024];
+
+    while (!in.empty())
+    {
+        const ConvertResult result{encode(in, block, sizeof(block))};
+        out = std::copy(block, block + result.produced, out);
+
+        if ((result.error != std::string_view::npos) || (result.consumed == 0))
+            break;
+
+        in = in.subspan(result.consumed);
+    }
+
+    return out;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Allocator aware versions of the functions that generate strings.
+
+/**
+ * @brief An allocator of chars, such as std::allocator<char> or
+ * std::pmr::polymorphic_allocator<char>.
+ */
+template<typename A>
+concept CharAllocator = requires(A & allocator)
+{
+    { allocator.allocate(size_t{1}) } -> std::same_as<char *>;
+};
+
+/**
+ * @brief A string using the given allocator.
+ */
+template<typename Allocator>
+using String = std::basic_string<char, std::char_traits<char>, Allocator>;
+
+/**
+ * @brief Generate a UTF-8 character as a string from unicode, using the
+ * given allocator.
+ * 
+ * @param unicode value to encode as a UTF-8 character.
+ * @param allocator to allocate the string with.
+ * @return String<Allocator> the encoded UTF-8 character, empty if invalid.
+ */
+template<CharAllocator Allocator>
+String<Allocator> unicodeToUtf8(int unicode, const Allocator & allocator)
+{
+    String<Allocator> output(allocator);
+    unicodeToUtf8(unicode, output);
+
+    return output;
+}
+
+/**
+ * @brief Generate the UTF-8 version of ISO/IEC 8859-1 characters, using the
+ * given allocator.
+ * 
+ * @param in string containing ISO/IEC 8859-1 characters.
+ * @param allocator to allocate the string with.
+ * @return String<Allocator> the UTF-8 string.
+ */
+template<CharAllocator Allocator>
+String<Allocator> latin1ToUtf8(const std::string_view & in, const Allocator & allocator)
+{
+    String<Allocator> output(allocator);
+    output.reserve(latin1ToUtf8Length(in));
+    latin1ToUtf8(in, output);
+
+    return output;
+}
+
+/**
+ * @brief Generate a copy of a string with ISO/IEC 8859-1 & UTF-8 characters
+ * replaced by character references, using the given allocator.
+ * 
+ * @param buffer containing ISO/IEC 8859-1 & UTF-8 characters to be replaced.
+ * @param allocator to allocate the string with.
+ * @return String<Allocator> the string with character references.
+ */
+template<CharAllocator Allocator>
+String<Allocator> useCharacterRefs(const std::string_view & buffer, const Allocator & allocator)
+{
+    String<Allocator> output(allocator);
+    output.reserve(characterRefsLength(buffer));
+    writeCharacterRefs(buffer, output);
+
+    return output;
+}
+
+/**
+ * @brief Generate an escaped copy of a string, as escapeCopy(), using the
+ * given allocator.
+ * 
+ * @param buffer the string to escape.
+ * @param options the escaping options.
+ * @param allocator to allocate the string with.
+ * @return String<Allocator> the escaped string.
+ */
+template<CharAllocator Allocator>
+String<Allocator> escapeCopy(const std::string_view & buffer, const EscapeOptions & options, const Allocator & allocator)
+{
+    String<Allocator> output(allocator);
+    output.reserve(buffer.length());
+    writeEscaped(buffer, output, options);
+
+    return output;
+}
+
+/**
+ * @brief Generate an unescaped copy of a string, as unescapeCopy(), using
+ * the given allocator.
+ * 
+ * @param buffer containing the character references to be replaced.
+ * @param allocator to allocate the string with.
+ * @return String<Allocator> the unescaped string.
+ */
+template<CharAllocator Allocator>
+String<Allocator> unescapeCopy(const std::string_view & buffer, const Allocator & allocator)
+{
+    String<Allocator> output(allocator);
+    output.reserve(buffer.length());
+    writeUnescaped(buffer, output);
+
+    return output;
+}
+
+/**
+ * @brief Generate an uppercase copy of a string, as toUpperCopy(), using the
+ * given allocator.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 lowercase characters.
+ * @param allocator to allocate the string with.
+ * @return String<Allocator> the uppercase string.
+ */
+template<CharAllocator Allocator>
+String<Allocator> toUpperCopy(const std::string_view & buffer, const Allocator & allocator)
+{
+    String<Allocator> output(allocator);
+    output.reserve(buffer.length());
+    toUpperCopy(buffer, output);
+
+    return output;
+}
+
+/**
+ * @brief Generate a lowercase copy of a string, as toLowerCopy(), using the
+ * given allocator.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 uppercase characters.
+ * @param allocator to allocate the string with.
+ * @return String<Allocator> the lowercase string.
+ */
+template<CharAllocator Allocator>
+String<Allocator> toLowerCopy(const std::string_view & buffer, const Allocator & allocator)
+{
+    String<Allocator> output(allocator);
+    output.reserve(buffer.length());
+    toLowerCopy(buffer, output);
+
+    return output;
+}
+
+/**
+ * @brief Generate a case folded copy of a string, as caseFold(), using the
+ * given allocator.
+ * 
+ * @param buffer possibly containing ASCII or UTF-8 characters.
+ * @param allocator to allocate the string with.
+ * @return String<Allocator> the case folded string.
+ */
+template<CharAllocator Allocator>
+String<Allocator> caseFold(const std::string_view & buffer, const Allocator & allocator)
+{
+    String<Allocator> output(allocator);
+    output.reserve(buffer.length());
+    caseFold(buffer, output);
+
+    return output;
+}
+
+/**
+ * @brief Versions of the functions that generate strings returning the
+ * std::pmr types, allocated from a memory resource such as a
+ * std::pmr::monotonic_buffer_resource released after each request.
+ */
+namespace pmr {
+
+inline std::pmr::string unicodeToUtf8(int unicode, std::pmr::memory_resource * resource)
+{
+    return utf8::unicodeToUtf8(unicode, std::pmr::polymorphic_allocator<char>{resource});
+}
+
+template<typename T = char>
+std::pmr::vector<T> unicodeToUtf8Vector(int unicode, std::pmr::memory_resource * resource)
+{
+    return utf8::unicodeToUtf8Vector<T>(unicode, std::pmr::polymorphic_allocator<T>{resource});
+}
+
+inline std::pmr::string latin1ToUtf8(const std::string_view & in, std::pmr::memory_resource * resource)
+{
+    return utf8::latin1ToUtf8(in, std::pmr::polymorphic_allocator<char>{resource});
+}
+
+inline std::pmr::string useCharacterRefs(const std::string_view & buffer, std::pmr::memory_resource * resource)
+{
+    return utf8::useCharacterRefs(buffer, std::pmr::polymorphic_allocator<char>{resource});
+}
+
+inline std::pmr::string escapeCopy(const std::string_view & buffer, const EscapeOptions & options, std::pmr::memory_resource * resource)
+{
+    return utf8::escapeCopy(buffer, options, std::pmr::polymorphic_allocator<char>{resource});
+}
+
+inline std::pmr::string unescapeCopy(const std::string_view & buffer, std::pmr::memory_resource * resource)
+{
+    return utf8::unescapeCopy(buffer, std::pmr::polymorphic_allocator<char>{resource});
+}
+
+inline std::pmr::string toUpperCopy(const std::string_view & buffer, std::pmr::memory_resource * resource)
+{
+    return utf8::toUpperCopy(buffer, std::pmr::polymorphic_allocator<char>{resource});
+}
+
+inline std::pmr::string toLowerCopy(const std::string_view & buffer, std::pmr::memory_resource * resource)
+{
+    return utf8::toLowerCopy(buffer, std::pmr::polymorphic_allocator<char>{resource});
+}
+
+inline std::pmr::string caseFold(const std::string_view & buffer, std::pmr::memory_resource * resource)
+{
+    return utf8::caseFold(buffer, std::pmr::polymorphic_allocator<char>{resource});
+}
+
+}   // end namespace pmr
+
+/**
+ * @brief Incremental UTF-8 decoder for input that arrives in chunks, such as
+ * from a socket or file. Up to 3 bytes of a character split across chunks are
+ * held between calls, the rest of each chunk is validated in place without
+ * being copied.
+ */
+class StreamDecoder
+{
+public:
+    /**
+     * @brief The validated characters of a chunk. head is a character
+     * completed from the bytes held from earlier chunks (it refers to the
+     * decoder and is only valid until the next call), body refers to the
+     * complete characters in the chunk.
+     */
+    struct Spans
+    {
+        std::string_view head{};
+        std::string_view body{};
+        size_t error{std::string_view::npos};   // Offset of first invalid byte.
+    };
+
+    Spans feed(const std::string_view & chunk);
+    bool finish(void);
+    void reset(void) { held = 0; }
+    size_t pending(void) const { return held; }
+
+    template<typename F>
+    bool decode(const std::string_view & chunk, F && emit);
+
+private:
+    char bytes[4]{};        // Incomplete character held between chunks.
+    char head[4]{};         // Last character completed from held bytes.
+    size_t held{};
+
+};
+
+/**
+ * @brief Decode a chunk of UTF-8, calling emit with each complete unicode
+ * value. The values are decoded a block at a time into a local buffer.
+ * 
+ * @param chunk the next part of the input.
+ * @param emit callable taking a char32_t.
+ * @return true if the chunk is valid so far, false otherwise.
+ */
+template<typename F>
+bool StreamDecoder::decode(const std::string_view & chunk, F && emit)
+{
+    const Spans spans{feed(chunk)};
+    char32_t block[256];
+
+    for (std::string_view part : { spans.head, spans.body })
+    {
+        while (!part.empty())
+        {
+            const ConvertResult result{utf8::decode(part, block, 256)};
+            for (size_t i{}; i < result.produced; ++i)
+                emit(block[i]);
+
+            part.remove_prefix(result.consumed);
+        }
+    }
+
+    return spans.error == std::string_view::npos;
+}
+
+/**
+ * @brief Bidirectional iterator over the unicode values of a UTF-8 buffer,
+ * decoding in place without copying or slicing the buffer. Each invalid byte
+ * yields U+FFFD and is stepped over on its own, so iteration always advances
+ * and stepping backwards visits the same positions as stepping forwards.
+ */
+class CodePointIterator
+{
+public:
+    using iterator_concept = std::bidirectional_iterator_tag;
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = char32_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = char32_t;
+
+    constexpr CodePointIterator(void) = default;
+    constexpr CodePointIterator(const char * begin, const char * pos, const char * end) :
+        first{begin}, current{pos}, last{end} {}
+
+    constexpr char32_t operator*(void) const;
+    constexpr CodePointIterator & operator++(void);
+    constexpr CodePointIterator & operator--(void);
+    constexpr CodePointIterator operator++(int) { CodePointIterator old{*this}; ++*this; return old; }
+    constexpr CodePointIterator operator--(int) { CodePointIterator old{*this}; --*this; return old; }
+
+    constexpr bool operator==(const CodePointIterator & other) const { return current == other.current; }
+
+    constexpr size_t offset(void) const { return current - first; }
+    constexpr size_t size(void) const;
+    constexpr bool valid(void) const { return sequenceLength(current, last) != 0; }
+    constexpr std::string_view bytes(void) const { return std::string_view{current, size()}; }
+
+private:
+    const char * first{};
+    const char * current{};
+    const char * last{};
+
+};
+
+/**
+ * @brief Get the unicode value of the current character.
+ * 
+ * @return char32_t the value, or U+FFFD if the current byte is invalid.
+ */
+constexpr char32_t CodePointIterator::operator*(void) const
+{
+    const size_t len{sequenceLength(current, last)};
+
+    return len ? decodeSequence(current, len) : replacementCharacter;
+}
+
+/**
+ * @brief Get the number of bytes in the current character.
+ * 
+ * @return size_t the UTF-8 byte count, 1 for an invalid byte.
+ */
+constexpr size_t CodePointIterator::size(void) const
+{
+    const size_t len{sequenceLength(current, last)};
+
+    return len ? len : 1;
+}
+
+/**
+ * @brief Step to the next character.
+ * 
+ * @return CodePointIterator & this iterator.
+ */
+constexpr CodePointIterator & CodePointIterator::operator++(void)
+{
+    current += size();
+
+    return *this;
+}
+
+/**
+ * @brief Step back to the start of the previous character.
+ * 
+ * @return CodePointIterator & this iterator.
+ */
+constexpr CodePointIterator & CodePointIterator::operator--(void)
+{
+    current = first + prevCharStart(std::string_view{first, (size_t)(last - first)}, current - first);
+
+    return *this;
+}
+
+/**
+ * @brief A view of the unicode values of a UTF-8 buffer, for range based for
+ * loops and the range algorithms. The view refers to the buffer, which must
+ * outlive it.
+ */
+class CodePoints : public std::ranges::view_interface<CodePoints>
+{
+public:
+    constexpr CodePoints(void) = default;
+    constexpr explicit CodePoints(std::string_view buffer) : text{buffer} {}
+
+    constexpr CodePointIterator begin(void) const { return CodePointIterator{text.data(), text.data(), text.data() + text.length()}; }
+    constexpr CodePointIterator end(void) const { return CodePointIterator{text.data(), text.data() + text.length(), text.data() + text.length()}; }
+
+    constexpr std::reverse_iterator<CodePointIterator> rbegin(void) const { return std::reverse_iterator{end()}; }
+    constexpr std::reverse_iterator<CodePointIterator> rend(void) const { return std::reverse_iterator{begin()}; }
+
+    constexpr std::string_view base(void) const { return text; }
+
+private:
+    std::string_view text{};
+
+};
+
+/**
+ * @brief Get a view of the unicode values of a UTF-8 buffer.
+ * 
+ * @param buffer possibly containing UTF-8 characters.
+ * @return CodePoints the view.
+ */
+constexpr CodePoints codePoints(std::string_view buffer)
+{
+    return CodePoints{buffer};
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Compile time validation, counting and conversion.
+
+/**
+ * @brief Versions of validate(), findInvalid(), charCount(), decode() and
+ * encode() that can be used in constant expressions. They give the same
+ * results as the runtime versions, which should still be used at run time
+ * as they use the block kernels.
+ */
+namespace constant {
+
+/**
+ * @brief Find the first byte that is not part of a valid UTF-8 character.
+ *
+ * @param buffer possibly containing UTF-8 characters.
+ * @return size_t offset of the first invalid byte, or npos if all valid.
+ */
+constexpr size_t findInvalid(std::string_view buffer)
+{
+    const char * begin{buffer.data()};
+    const char * end{begin + buffer.length()};
+
+    for (const char * p{begin}; p != end; )
+    {
+        const size_t len{sequenceLength(p, end)};
+        if (!len)
+            return p - begin;
+
+        p += len;
+    }
+
+    return std::string_view::npos;
+}
+
+/**
+ * @brief Check that a string contains only valid UTF-8 characters.
+ *
+ * @param buffer possibly containing UTF-8 characters.
+ * @return true if all characters are valid, false otherwise.
+ */
+constexpr bool validate(std::string_view buffer)
+{
+    return findInvalid(buffer) == std::string_view::npos;
+}
+
+/**
+ * @brief Count the number of characters in the string, counting each byte
+ * that is not part of a valid UTF-8 character as a character.
+ *
+ * @param buffer possibly containing UTF-8 characters.
+ * @return size_t character count.
+ */
+constexpr size_t charCount(std::string_view buffer)
+{
+    const char * p{buffer.data()};
+    const char * end{p + buffer.length()};
+
+    size_t count{};
+    for (; p != end; ++count)
+    {
+        const size_t len{sequenceLength(p, end)};
+        p += len ? len : 1;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Decode a string of UTF-8 characters into a buffer of unicode values.
+ *
+ * @param in string containing the UTF-8 characters.
+ * @param out buffer to receive the unicode values.
+ * @param cap the number of values out can hold.
+ * @return ConvertResult bytes consumed, values produced and the offset of the
+ *         first invalid character if decoding stopped there.
+ */
+constexpr ConvertResult decode(std::string_view in, char32_t * out, size_t cap)
+{
+    const char * begin{in.data()};
+    const char * end{begin + in.length()};
+
+    ConvertResult result{};
+    while ((result.consumed < in.length()) && (result.produced < cap))
+    {
+        const size_t len{sequenceLength(begin + result.consumed, end)};
+        if (!len)
+        {
+            result.error = result.consumed;
+            break;
+        }
+
+        out[result.produced++] = decodeSequence(begin + result.consumed, len);
+        result.consumed += len;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Encode unicode values as UTF-8 characters into a buffer. Characters
+ * are never split across the end of the buffer.
+ *
+ * @param in unicode values to encode.
+ * @param out buffer to receive the UTF-8 characters.
+ * @param cap the number of bytes out can hold.
+ * @return ConvertResult values consumed, bytes produced and the index of the
+ *         first invalid value if encoding stopped there.
+ */
+constexpr ConvertResult encode(std::span<const char32_t> in, char * out, size_t cap)
+{
+    ConvertResult result{};
+    for (; result.consumed < in.size(); ++result.consumed)
+    {
+        char bytes[4]{};
+        const size_t len{utf8::encode(in[result.consumed], bytes)};
+        if (!len)
+        {
+            result.error = result.consumed;
+            break;
+        }
+
+        if (cap - result.produced < len)
+            break;
+
+        for (size_t i{}; i < len; ++i)
+            out[result.produced++] = bytes[i];
+    }
+
+    return result;
+}
+
+}   // end namespace constant
+
+/**
+ * @brief Deliberately not defined, so that a Literal that is not valid UTF-8
+ * fails to compile with this name in the error.
+ */
+extern void invalidUtf8Literal(void);
+
+/**
+ * @brief A string literal checked for valid UTF-8 at compile time, carrying
+ * its character count, so constant strings need no work at run time. It is
+ * a structural type, so can also be used as a template argument, as with
+ * literal<"..."> and the _utf8 suffix.
+ */
+template<size_t N>
+struct Literal
+{
+    consteval Literal(const char (&text)[N])
+    {
+        std::copy_n(text, N, bytes);
+        if (!constant::validate(view()))
+            invalidUtf8Literal();
+
+        count = constant::charCount(view());
+    }
+
+    constexpr size_t size(void) const { return N - 1; }
+    constexpr size_t length(void) const { return count; }
+    constexpr const char * data(void) const { return bytes; }
+    constexpr const char * c_str(void) const { return bytes; }
+
+    constexpr std::string_view view(void) const { return std::string_view{bytes, N - 1}; }
+    constexpr operator std::string_view(void) const { return view(); }
+    constexpr CodePoints codePoints(void) const { return CodePoints{view()}; }
+
+    char bytes[N]{};
+    size_t count{};
+
+};
+
+/**
+ * @brief A Literal as a constant, so each string is stored only once.
+ */
+template<Literal text>
+inline constexpr auto literal{text};
+
+namespace literals {
+
+/**
+ * @brief Make a Literal from a string literal, as "text"_utf8.
+ */
+template<Literal text>
+consteval auto operator""_utf8(void)
+{
+    return text;
+}
+
+}   // end namespace literals
+
+/**
+ * @brief A UTF-8 string with a sparse index of character positions, so that
+ * converting between character indexes and byte offsets examines no more
+ * than one interval of characters. The index records the byte offset of
+ * every 64th character, is built on first use and is extended, rather than
+ * rebuilt, after an append. Characters are counted as codePoints(), with
+ * each invalid byte counted as a character. The lookups update the index, so
+ * a const IndexedString must not be shared between threads without locking.
+ */
+class IndexedString
+{
+public:
+    static constexpr size_t interval{64};
+
+    IndexedString(void) = default;
+    explicit IndexedString(std::string buffer) : text{std::move(buffer)} {}
+
+    void append(const std::string_view & buffer);
+
+    const std::string & str(void) const { return text; }
+    std::string_view view(void) const { return text; }
+    size_t size(void) const { return text.length(); }
+
+    size_t length(void) const;
+    size_t byteOffset(size_t index) const;
+    size_t charIndex(size_t offset) const;
+    char32_t at(size_t index) const;
+
+private:
+    void buildIndex(void) const;
+
+    std::string text{};
+    mutable std::vector<size_t> checkpoints{};  // Offset of every 64th character.
+    mutable size_t indexed{};                   // Bytes covered by the index.
+    mutable size_t count{};                     // Characters in those bytes.
+
+};
+
 }   // end namespace
 
+template<>
+inline constexpr bool std::ranges::enable_borrowed_range<utf8::CodePoints> = true;
+
 #endif // !defined(_UTF_8_H__20211017_1938__INCLUDED_)